@@ -0,0 +1,8 @@
+#! /usr/bin/env python
+
+# Programs that are runnable.
+ns3_runnable_programs = ['build/src/aodv/examples/ns3.26-aodv-debug', 'build/src/bridge/examples/ns3.26-csma-bridge-debug', 'build/src/bridge/examples/ns3.26-csma-bridge-one-hop-debug', 'build/src/buildings/examples/ns3.26-buildings-pathloss-profiler-debug', 'build/src/config-store/examples/ns3.26-config-store-save-debug', 'build/src/core/examples/ns3.26-main-callback-debug', 'build/src/core/examples/ns3.26-sample-simulator-debug', 'build/src/core/examples/ns3.26-main-ptr-debug', 'build/src/core/examples/ns3.26-main-random-variable-debug', 'build/src/core/examples/ns3.26-main-random-variable-stream-debug', 'build/src/core/examples/ns3.26-sample-random-variable-debug', 'build/src/core/examples/ns3.26-sample-random-variable-stream-debug', 'build/src/core/examples/ns3.26-command-line-example-debug', 'build/src/core/examples/ns3.26-hash-example-debug', 'build/src/core/examples/ns3.26-test-string-value-formatting-debug', 'build/src/core/examples/ns3.26-main-test-sync-debug', 'build/src/csma/examples/ns3.26-csma-one-subnet-debug', 'build/src/csma/examples/ns3.26-csma-broadcast-debug', 'build/src/csma/examples/ns3.26-csma-packet-socket-debug', 'build/src/csma/examples/ns3.26-csma-multicast-debug', 'build/src/csma/examples/ns3.26-csma-raw-ip-socket-debug', 'build/src/csma/examples/ns3.26-csma-ping-debug', 'build/src/csma-layout/examples/ns3.26-csma-star-debug', 'build/src/dsdv/examples/ns3.26-dsdv-manet-debug', 'build/src/dsr/examples/ns3.26-dsr-debug', 'build/src/energy/examples/ns3.26-li-ion-energy-source-debug', 'build/src/energy/examples/ns3.26-rv-battery-model-test-debug', 'build/src/energy/examples/ns3.26-basic-energy-model-test-debug', 'build/src/fd-net-device/examples/ns3.26-dummy-network-debug', 'build/src/fd-net-device/examples/ns3.26-fd2fd-onoff-debug', 'build/src/fd-net-device/examples/ns3.26-realtime-dummy-network-debug', 'build/src/fd-net-device/examples/ns3.26-realtime-fd2fd-onoff-debug', 'build/src/fd-net-device/examples/ns3.26-fd-emu-ping-debug', 'build/src/fd-net-device/examples/ns3.26-fd-emu-udp-echo-debug', 'build/src/fd-net-device/examples/ns3.26-fd-emu-onoff-debug', 'build/src/fd-net-device/examples/ns3.26-fd-tap-ping-debug', 'build/src/fd-net-device/examples/ns3.26-fd-tap-ping6-debug', 'build/src/internet/examples/ns3.26-main-simple-debug', 'build/src/lr-wpan/examples/ns3.26-lr-wpan-packet-print-debug', 'build/src/lr-wpan/examples/ns3.26-lr-wpan-phy-test-debug', 'build/src/lr-wpan/examples/ns3.26-lr-wpan-data-debug', 'build/src/lr-wpan/examples/ns3.26-lr-wpan-error-model-plot-debug', 'build/src/lr-wpan/examples/ns3.26-lr-wpan-error-distance-plot-debug', 'build/src/lte/examples/ns3.26-lena-cqi-threshold-debug', 'build/src/lte/examples/ns3.26-lena-dual-stripe-debug', 'build/src/lte/examples/ns3.26-lena-fading-debug', 'build/src/lte/examples/ns3.26-lena-intercell-interference-debug', 'build/src/lte/examples/ns3.26-lena-pathloss-traces-debug', 'build/src/lte/examples/ns3.26-lena-profiling-debug', 'build/src/lte/examples/ns3.26-lena-rem-debug', 'build/src/lte/examples/ns3.26-lena-rem-sector-antenna-debug', 'build/src/lte/examples/ns3.26-lena-rlc-traces-debug', 'build/src/lte/examples/ns3.26-lena-simple-debug', 'build/src/lte/examples/ns3.26-lena-simple-epc-debug', 'build/src/lte/examples/ns3.26-lena-deactivate-bearer-debug', 'build/src/lte/examples/ns3.26-lena-x2-handover-debug', 'build/src/lte/examples/ns3.26-lena-x2-handover-measures-debug', 'build/src/lte/examples/ns3.26-lena-frequency-reuse-debug', 'build/src/lte/examples/ns3.26-lena-distributed-ffr-debug', 'build/src/lte/examples/ns3.26-lena-uplink-power-control-debug', 'build/src/mesh/examples/ns3.26-mesh-debug', 'build/src/mobility/examples/ns3.26-main-grid-topology-debug', 'build/src/mobility/examples/ns3.26-main-random-topology-debug', 'build/src/mobility/examples/ns3.26-main-random-walk-debug', 'build/src/mobility/examples/ns3.26-mobility-trace-example-debug', 'build/src/mobility/examples/ns3.26-ns2-mobility-trace-debug', 'build/src/mobility/examples/ns3.26-bonnmotion-ns2-example-debug', 'build/src/mpi/examples/ns3.26-simple-distributed-debug', 'build/src/mpi/examples/ns3.26-third-distributed-debug', 'build/src/mpi/examples/ns3.26-nms-p2p-nix-distributed-debug', 'build/src/mpi/examples/ns3.26-simple-distributed-empty-node-debug', 'build/src/netanim/examples/ns3.26-dumbbell-animation-debug', 'build/src/netanim/examples/ns3.26-grid-animation-debug', 'build/src/netanim/examples/ns3.26-star-animation-debug', 'build/src/netanim/examples/ns3.26-wireless-animation-debug', 'build/src/netanim/examples/ns3.26-uan-animation-debug', 'build/src/netanim/examples/ns3.26-colors-link-description-debug', 'build/src/netanim/examples/ns3.26-resources-counters-debug', 'build/src/network/examples/ns3.26-main-packet-header-debug', 'build/src/network/examples/ns3.26-main-packet-tag-debug', 'build/src/network/examples/ns3.26-packet-socket-apps-debug', 'build/src/nix-vector-routing/examples/ns3.26-nix-simple-debug', 'build/src/nix-vector-routing/examples/ns3.26-nms-p2p-nix-debug', 'build/src/olsr/examples/ns3.26-simple-point-to-point-olsr-debug', 'build/src/olsr/examples/ns3.26-olsr-hna-debug', 'build/src/point-to-point/examples/ns3.26-main-attribute-value-debug', 'build/src/propagation/examples/ns3.26-main-propagation-loss-debug', 'build/src/propagation/examples/ns3.26-jakes-propagation-model-example-debug', 'build/src/sixlowpan/examples/ns3.26-example-sixlowpan-debug', 'build/src/sixlowpan/examples/ns3.26-example-ping-lr-wpan-debug', 'build/src/spectrum/examples/ns3.26-adhoc-aloha-ideal-phy-debug', 'build/src/spectrum/examples/ns3.26-adhoc-aloha-ideal-phy-matrix-propagation-loss-model-debug', 'build/src/spectrum/examples/ns3.26-adhoc-aloha-ideal-phy-with-microwave-oven-debug', 'build/src/spectrum/examples/ns3.26-tv-trans-example-debug', 'build/src/spectrum/examples/ns3.26-tv-trans-regional-example-debug', 'build/src/stats/examples/ns3.26-gnuplot-example-debug', 'build/src/stats/examples/ns3.26-double-probe-example-debug', 'build/src/stats/examples/ns3.26-time-probe-example-debug', 'build/src/stats/examples/ns3.26-gnuplot-aggregator-example-debug', 'build/src/stats/examples/ns3.26-gnuplot-helper-example-debug', 'build/src/stats/examples/ns3.26-file-aggregator-example-debug', 'build/src/stats/examples/ns3.26-file-helper-example-debug', 'build/src/stats/examples/ns3.26-binary-file-aggregator-example-debug', 'build/src/tap-bridge/examples/ns3.26-tap-csma-debug', 'build/src/tap-bridge/examples/ns3.26-tap-csma-virtual-machine-debug', 'build/src/tap-bridge/examples/ns3.26-tap-wifi-virtual-machine-debug', 'build/src/tap-bridge/examples/ns3.26-tap-wifi-dumbbell-debug', 'build/src/topology-read/examples/ns3.26-topology-example-sim-debug', 'build/src/traffic-control/examples/ns3.26-red-tests-debug', 'build/src/traffic-control/examples/ns3.26-red-vs-ared-debug', 'build/src/traffic-control/examples/ns3.26-adaptive-red-tests-debug', 'build/src/traffic-control/examples/ns3.26-pfifo-vs-red-debug', 'build/src/traffic-control/examples/ns3.26-codel-vs-pfifo-basic-test-debug', 'build/src/traffic-control/examples/ns3.26-codel-vs-pfifo-asymmetric-debug', 'build/src/traffic-control/examples/ns3.26-pie-example-debug', 'build/src/uan/examples/ns3.26-uan-cw-example-debug', 'build/src/uan/examples/ns3.26-uan-rc-example-debug', 'build/src/virtual-net-device/examples/ns3.26-virtual-net-device-debug', 'build/src/wave/examples/ns3.26-wave-simple-80211p-debug', 'build/src/wave/examples/ns3.26-wave-simple-device-debug', 'build/src/wave/examples/ns3.26-vanet-routing-compare-debug', 'build/src/wifi/examples/ns3.26-wifi-phy-test-debug', 'build/src/wifi/examples/ns3.26-test-interference-helper-debug', 'build/src/wifi/examples/ns3.26-ideal-wifi-manager-example-debug', 'build/src/wifi/examples/ns3.26-minstrel-ht-wifi-manager-example-debug', 'build/src/wifi/examples/ns3.26-wifi-phy-configuration-debug', 'build/src/wimax/examples/ns3.26-wimax-ipv4-debug', 'build/src/wimax/examples/ns3.26-wimax-multicast-debug', 'build/src/wimax/examples/ns3.26-wimax-simple-debug', 'build/examples/tcp/ns3.26-tcp-large-transfer-debug', 'build/examples/tcp/ns3.26-tcp-nsc-lfn-debug', 'build/examples/tcp/ns3.26-tcp-nsc-zoo-debug', 'build/examples/tcp/ns3.26-tcp-star-server-debug', 'build/examples/tcp/ns3.26-star-debug', 'build/examples/tcp/ns3.26-tcp-bulk-send-debug', 'build/examples/tcp/ns3.26-tcp-pcap-nanosec-example-debug', 'build/examples/tcp/ns3.26-tcp-nsc-comparison-debug', 'build/examples/tcp/ns3.26-tcp-variants-comparison-debug', 'build/examples/energy/ns3.26-energy-model-example-debug', 'build/examples/energy/ns3.26-energy-model-with-harvesting-example-debug', 'build/examples/routing/ns3.26-dynamic-global-routing-debug', 'build/examples/routing/ns3.26-static-routing-slash32-debug', 'build/examples/routing/ns3.26-global-routing-slash32-debug', 'build/examples/routing/ns3.26-global-injection-slash32-debug', 'build/examples/routing/ns3.26-simple-global-routing-debug', 'build/examples/routing/ns3.26-simple-alternate-routing-debug', 'build/examples/routing/ns3.26-mixed-global-routing-debug', 'build/examples/routing/ns3.26-simple-routing-ping6-debug', 'build/examples/routing/ns3.26-manet-routing-compare-debug', 'build/examples/routing/ns3.26-ripng-simple-network-debug', 'build/examples/routing/ns3.26-rip-simple-network-debug', 'build/examples/routing/ns3.26-global-routing-multi-switch-plus-router-debug', 'build/examples/stats/ns3.26-wifi-example-sim-debug', 'build/examples/udp-client-server/ns3.26-udp-client-server-debug', 'build/examples/udp-client-server/ns3.26-udp-trace-client-server-debug', 'build/examples/error-model/ns3.26-simple-error-model-debug', 'build/examples/wireless/ns3.26-mixed-wireless-debug', 'build/examples/wireless/ns3.26-wifi-adhoc-debug', 'build/examples/wireless/ns3.26-wifi-clear-channel-cmu-debug', 'build/examples/wireless/ns3.26-wifi-ap-debug', 'build/examples/wireless/ns3.26-wifi-wired-bridging-debug', 'build/examples/wireless/ns3.26-multirate-debug', 'build/examples/wireless/ns3.26-wifi-simple-adhoc-debug', 'build/examples/wireless/ns3.26-wifi-simple-adhoc-grid-debug', 'build/examples/wireless/ns3.26-wifi-simple-infra-debug', 'build/examples/wireless/ns3.26-wifi-simple-interference-debug', 'build/examples/wireless/ns3.26-wifi-blockack-debug', 'build/examples/wireless/ns3.26-ofdm-validation-debug', 'build/examples/wireless/ns3.26-ofdm-ht-validation-debug', 'build/examples/wireless/ns3.26-ofdm-vht-validation-debug', 'build/examples/wireless/ns3.26-wifi-hidden-terminal-debug', 'build/examples/wireless/ns3.26-ht-wifi-network-debug', 'build/examples/wireless/ns3.26-vht-wifi-network-debug', 'build/examples/wireless/ns3.26-wifi-timing-attributes-debug', 'build/examples/wireless/ns3.26-wifi-sleep-debug', 'build/examples/wireless/ns3.26-power-adaptation-distance-debug', 'build/examples/wireless/ns3.26-power-adaptation-interference-debug', 'build/examples/wireless/ns3.26-rate-adaptation-distance-debug', 'build/examples/wireless/ns3.26-wifi-aggregation-debug', 'build/examples/wireless/ns3.26-simple-ht-hidden-stations-debug', 'build/examples/wireless/ns3.26-80211n-mimo-debug', 'build/examples/wireless/ns3.26-mixed-bg-network-debug', 'build/examples/wireless/ns3.26-wifi-tcp-debug', 'build/examples/wireless/ns3.26-80211e-txop-debug', 'build/examples/wireless/ns3.26-wifi-spectrum-per-example-debug', 'build/examples/wireless/ns3.26-wifi-spectrum-per-interference-debug', 'build/examples/wireless/ns3.26-wifi-spectrum-saturation-example-debug', 'build/examples/tutorial/ns3.26-hello-simulator-debug', 'build/examples/tutorial/ns3.26-first-debug', 'build/examples/tutorial/ns3.26-second-debug', 'build/examples/tutorial/ns3.26-third-debug', 'build/examples/tutorial/ns3.26-fourth-debug', 'build/examples/tutorial/ns3.26-fifth-debug', 'build/examples/tutorial/ns3.26-sixth-debug', 'build/examples/tutorial/ns3.26-seventh-debug', 'build/examples/udp/ns3.26-udp-echo-debug', 'build/examples/socket/ns3.26-socket-bound-static-routing-debug', 'build/examples/socket/ns3.26-socket-bound-tcp-static-routing-debug', 'build/examples/socket/ns3.26-socket-options-ipv4-debug', 'build/examples/socket/ns3.26-socket-options-ipv6-debug', 'build/examples/realtime/ns3.26-realtime-udp-echo-debug', 'build/examples/naming/ns3.26-object-names-debug', 'build/examples/ipv6/ns3.26-icmpv6-redirect-debug', 'build/examples/ipv6/ns3.26-ping6-debug', 'build/examples/ipv6/ns3.26-radvd-debug', 'build/examples/ipv6/ns3.26-radvd-two-prefix-debug', 'build/examples/ipv6/ns3.26-test-ipv6-debug', 'build/examples/ipv6/ns3.26-fragmentation-ipv6-debug', 'build/examples/ipv6/ns3.26-fragmentation-ipv6-two-MTU-debug', 'build/examples/ipv6/ns3.26-loose-routing-ipv6-debug', 'build/examples/ipv6/ns3.26-wsn-ping6-debug', 'build/examples/traffic-control/ns3.26-traffic-control-debug', 'build/examples/traffic-control/ns3.26-queue-discs-benchmark-debug', 'build/examples/matrix-topology/ns3.26-matrix-topology-debug', 'build/scratch/subdir/ns3.26-subdir-debug', 'build/scratch/ns3.26-scratch-simulator-debug']
+
+# Scripts that are runnable.
+ns3_runnable_scripts = ['csma-bridge.py', 'sample-simulator.py', 'wifi-olsr-flowmon.py', 'tap-csma-virtual-machine.py', 'tap-wifi-virtual-machine.py', 'simple-routing-ping6.py', 'mixed-wireless.py', 'wifi-ap.py', 'first.py', 'second.py', 'third.py', 'realtime-udp-echo.py']
+
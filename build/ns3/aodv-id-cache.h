@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 IITP RAS
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Based on
+ *      NS-2 AODV model developed by the CMU/MONARCH group and optimized and
+ *      tuned by Samir Das and Mahesh Marina, University of Cincinnati;
+ *
+ *      AODV-UU implementation by Erik Nordström of Uppsala University
+ *      http://core.it.uu.se/core/index.php/AODV-UU
+ *
+ * Authors: Elena Buchatskaia <borovkovaes@iitp.ru>
+ *          Pavel Boyko <boyko@iitp.ru>
+ */
+
+#ifndef AODV_ID_CACHE_H
+#define AODV_ID_CACHE_H
+
+#include "ns3/ipv4-address.h"
+#include "ns3/simulator.h"
+#include <map>
+#include <utility>
+
+namespace ns3
+{
+namespace aodv
+{
+/**
+ * \ingroup aodv
+ * 
+ * \brief Unique packets identification cache used for simple duplicate detection.
+ */
+class IdCache
+{
+public:
+  /// c-tor
+  IdCache (Time lifetime) : m_lifetime (lifetime) {}
+  /// Check that entry (addr, id) exists in cache. Add entry, if it doesn't exist.
+  bool IsDuplicate (Ipv4Address addr, uint32_t id);
+  /// Remove all expired entries
+  void Purge ();
+  /// Return number of entries in cache
+  uint32_t GetSize ();
+  /// Set lifetime for future added entries.
+  void SetLifetime (Time lifetime) { m_lifetime = lifetime; }
+  /// Return lifetime for existing entries in cache
+  Time GetLifeTime () const { return m_lifetime; }
+private:
+  /// Unique packet ID: the ID is supposed to be unique in single address context (e.g. sender address)
+  typedef std::pair<Ipv4Address, uint32_t> UniqueId;
+  /// Already seen IDs, with the time when the record will expire
+  std::map<UniqueId, Time> m_idCache;
+  /// Already seen IDs, by expiration time
+  std::multimap<Time, UniqueId> m_expirations;
+  /// Default lifetime for ID records
+  Time m_lifetime;
+};
+
+}
+}
+#endif /* AODV_ID_CACHE_H */
@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2010 Network Security Lab, University of Washington, Seattle.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Sidharth Nabar <snabar@uw.edu>, He Wu <mdzz@u.washington.edu>
+ */
+
+#ifndef BASIC_ENERGY_SOURCE_H
+#define BASIC_ENERGY_SOURCE_H
+
+#include "ns3/traced-value.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "energy-source.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup energy
+ * BasicEnergySource decreases/increases remaining energy stored in itself in
+ * linearly.
+ *
+ * By default, the remaining energy is updated periodically. When the
+ * PeriodicEnergyUpdateInterval attribute is zero, there is no periodic
+ * update: since the current drawn from the source does not change between
+ * two updates (device state changes and harvester updates update the
+ * source), the remaining energy is integrated only when it is queried or
+ * the current changes, and a single update is scheduled when the low
+ * (resp. high) battery threshold would be crossed.
+ *
+ */
+class BasicEnergySource : public EnergySource
+{
+public:
+  static TypeId GetTypeId (void);
+  BasicEnergySource ();
+  virtual ~BasicEnergySource ();
+
+  /**
+   * \return Initial energy stored in energy source, in Joules.
+   *
+   * Implements GetInitialEnergy.
+   */
+  virtual double GetInitialEnergy (void) const;
+
+  /**
+   * \returns Supply voltage at the energy source.
+   *
+   * Implements GetSupplyVoltage.
+   */
+  virtual double GetSupplyVoltage (void) const;
+
+  /**
+   * \return Remaining energy in energy source, in Joules
+   *
+   * Implements GetRemainingEnergy.
+   */
+  virtual double GetRemainingEnergy (void);
+
+  /**
+   * \returns Energy fraction.
+   *
+   * Implements GetEnergyFraction.
+   */
+  virtual double GetEnergyFraction (void);
+
+  /**
+   * Implements UpdateEnergySource.
+   */
+  virtual void UpdateEnergySource (void);
+
+  /**
+   * \param initialEnergyJ Initial energy, in Joules
+   *
+   * Sets initial energy stored in the energy source. Note that initial energy
+   * is assumed to be set before simulation starts and is set only once per
+   * simulation.
+   */
+  void SetInitialEnergy (double initialEnergyJ);
+
+  /**
+   * \param supplyVoltageV Supply voltage at the energy source, in Volts.
+   *
+   * Sets supply voltage of the energy source.
+   */
+  void SetSupplyVoltage (double supplyVoltageV);
+
+  /**
+   * \param interval Energy update interval.
+   *
+   * This function sets the interval between each energy update. No periodic
+   * update is done if the interval is zero.
+   */
+  void SetEnergyUpdateInterval (Time interval);
+
+  /**
+   * \returns The interval between each energy update.
+   */
+  Time GetEnergyUpdateInterval (void) const;
+
+
+private:
+  /// Defined in ns3::Object
+  void DoInitialize (void);
+
+  /// Defined in ns3::Object
+  void DoDispose (void);
+
+  /**
+   * Handles the remaining energy going to zero event. This function notifies
+   * all the energy models aggregated to the node about the energy being
+   * depleted. Each energy model is then responsible for its own handler.
+   */
+  void HandleEnergyDrainedEvent (void);
+
+  /**
+   * Handles the remaining energy exceeding the high threshold after it went
+   * below the low threshold. This function notifies all the energy models
+   * aggregated to the node about the energy being recharged. Each energy model
+   * is then responsible for its own handler.
+   */
+  void HandleEnergyRechargedEvent (void);
+
+  /**
+   * Updates the remaining energy before it is queried. Without periodic
+   * updates, the pending threshold update is kept, since a query does not
+   * change the current.
+   */
+  void UpdateOnQuery (void);
+
+  /**
+   * Calculates the remaining energy, and notifies the energy models when
+   * it crosses the low (resp. high) battery threshold.
+   */
+  void IntegrateRemainingEnergy (void);
+
+  /**
+   * Calculates remaining energy. This function uses the total current from all
+   * device models to calculate the amount of energy to decrease. The energy to
+   * decrease is given by:
+   *    energy to decrease = total current * supply voltage * time duration
+   * This function subtracts the calculated energy to decrease from remaining
+   * energy.
+   */
+  void CalculateRemainingEnergy (void);
+
+  /**
+   * Schedules the next energy update at the time the remaining energy
+   * crosses the low (resp. high) battery threshold, if the total current
+   * does not change until then. Called in an event of its own after each
+   * update, so that it uses the current set by the device model which
+   * triggered the update; the pending update is kept if that current is
+   * the one it was computed from.
+   */
+  void ScheduleThresholdUpdate (void);
+
+private:
+  double m_initialEnergyJ;                // initial energy, in Joules
+  double m_supplyVoltageV;                // supply voltage, in Volts
+  double m_lowBatteryTh;                  // low battery threshold, as a fraction of the initial energy
+  double m_highBatteryTh;                 // high battery threshold, as a fraction of the initial energy
+  bool m_depleted;                        // set to true when the remaining energy goes below the low threshold,
+                                          // set to false again when the remaining energy exceeds the high threshold
+  TracedValue<double> m_remainingEnergyJ; // remaining energy, in Joules
+  EventId m_energyUpdateEvent;            // energy update event
+  EventId m_currentCheckEvent;            // check of the current after an update, without periodic updates
+  Time m_lastUpdateTime;                  // last update time
+  Time m_energyUpdateInterval;            // energy update interval
+  double m_totalCurrentA;                 // total current the threshold update was computed from, in Amperes
+
+};
+
+} // namespace ns3
+
+#endif /* BASIC_ENERGY_SOURCE_H */
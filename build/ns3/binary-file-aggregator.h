@@ -0,0 +1,229 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_FILE_AGGREGATOR_H
+#define BINARY_FILE_AGGREGATOR_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "ns3/data-collection-object.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup aggregator
+ *
+ * This aggregator sends values it receives to a compact binary,
+ * column-oriented file.
+ *
+ * Each column has a type that selects how its values are encoded:
+ *
+ * - DOUBLE: the bit pattern of the value is XORed with the previous one
+ *   and only its non-zero bytes are stored;
+ * - INTEGER: the value is rounded to a 64-bit integer and the difference
+ *   with the previous value is stored as a zig-zag variable length integer;
+ * - TIME: the value is a time in seconds (e.g., the first output of a
+ *   TimeSeriesAdaptor), stored as a nanosecond INTEGER.
+ *
+ * Rows are accumulated in memory and written one block at a time, each
+ * column of a block being contiguous.  Slowly varying series, such as a
+ * queue length sampled on every enqueue, typically take one to three bytes
+ * per value.  The file is read back with BinaryFileReader.
+ *
+ * Columns are declared with AddColumn () before the first value is
+ * written.  If no column has been declared, DOUBLE columns named "v1",
+ * "v2", ... are created on the first write.
+ **/
+class BinaryFileAggregator : public DataCollectionObject
+{
+public:
+  /// The encoding of a column.
+  enum ColumnType
+  {
+    DOUBLE,
+    INTEGER,
+    TIME
+  };
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \param outputFileName name of the file to write.
+   *
+   * Constructs a binary file aggregator that will create a file named
+   * outputFileName.
+   */
+  BinaryFileAggregator (const std::string &outputFileName);
+
+  virtual ~BinaryFileAggregator ();
+
+  /**
+   * \brief Declare the next column of the file.
+   * \param name the column name.
+   * \param type the column encoding.
+   */
+  void AddColumn (const std::string &name, enum ColumnType type);
+
+  /**
+   * \brief Set the number of rows written to the file at once.
+   * \param rows the number of rows of a block.
+   */
+  void SetBlockSize (uint32_t rows);
+
+  /**
+   * \brief Write the rows accumulated so far to the file.
+   */
+  void Flush (void);
+
+  // Below are hooked to connectors exporting data
+  // They are not overloaded since it confuses the compiler when made
+  // into callbacks
+
+  /**
+   * \param context specifies the 1D dataset these values came from.
+   * \param v1 value for the new data point.
+   *
+   * \brief Writes 1 value to the file.
+   */
+  void Write1d (std::string context,
+                double v1);
+
+  /**
+   * \param context specifies the 2D dataset these values came from.
+   * \param v1 first value for the new data point.
+   * \param v2 second value for the new data point.
+   *
+   * \brief Writes 2 values to the file.
+   */
+  void Write2d (std::string context,
+                double v1,
+                double v2);
+
+  /**
+   * \param context specifies the 3D dataset these values came from.
+   * \param v1 first value for the new data point.
+   * \param v2 second value for the new data point.
+   * \param v3 third value for the new data point.
+   *
+   * \brief Writes 3 values to the file.
+   */
+  void Write3d (std::string context,
+                double v1,
+                double v2,
+                double v3);
+
+private:
+  /// A column being written.
+  struct Column
+  {
+    std::string name;          //!< Column name.
+    enum ColumnType type;      //!< Column encoding.
+    std::vector<uint8_t> data; //!< Encoded values of the current block.
+    uint64_t last;             //!< Previous value (bits or integer).
+  };
+
+  /**
+   * \brief Append a row to the current block.
+   * \param values the values of the row.
+   * \param n the number of values.
+   */
+  void WriteRow (const double *values, uint32_t n);
+
+  /// Write the file header.
+  void WriteHeader (void);
+
+  std::string m_outputFileName;  //!< The file name.
+  std::ofstream m_file;          //!< Used to write values to the file.
+  std::vector<Column> m_columns; //!< The file columns.
+  uint32_t m_blockSize;          //!< Number of rows in a block.
+  uint32_t m_rows;               //!< Rows in the current block.
+  bool m_headerWritten;          //!< True once the header is in the file.
+
+}; // class BinaryFileAggregator
+
+
+/**
+ * \ingroup aggregator
+ *
+ * Reads the files created by BinaryFileAggregator, one row at a time.
+ */
+class BinaryFileReader
+{
+public:
+  BinaryFileReader ();
+
+  /**
+   * \brief Open a file and read its header.
+   * \param fileName the file name.
+   * \returns false if the file cannot be opened or is not a valid file.
+   */
+  bool Open (const std::string &fileName);
+
+  /**
+   * \returns the number of columns of the file.
+   */
+  uint32_t GetNColumns (void) const;
+
+  /**
+   * \param i the column index.
+   * \returns the name of a column.
+   */
+  std::string GetColumnName (uint32_t i) const;
+
+  /**
+   * \param i the column index.
+   * \returns the type of a column.
+   */
+  enum BinaryFileAggregator::ColumnType GetColumnType (uint32_t i) const;
+
+  /**
+   * \brief Read the next row.
+   * \param row where the values are stored; TIME values are in seconds.
+   * \returns false at the end of the file.
+   */
+  bool ReadRow (std::vector<double> &row);
+
+private:
+  /// A column being read.
+  struct Column
+  {
+    std::string name;          //!< Column name.
+    enum BinaryFileAggregator::ColumnType type; //!< Column encoding.
+    std::vector<uint8_t> data; //!< Encoded values of the current block.
+    uint32_t pos;              //!< Read offset in data.
+    uint64_t last;             //!< Previous value (bits or integer).
+  };
+
+  /**
+   * \brief Load the next block of the file.
+   * \returns false if there is no more block.
+   */
+  bool ReadBlock (void);
+
+  std::ifstream m_file;          //!< The file being read.
+  std::vector<Column> m_columns; //!< The file columns.
+  uint32_t m_rowsLeft;           //!< Rows left in the current block.
+};
+
+} // namespace ns3
+
+#endif // BINARY_FILE_AGGREGATOR_H
@@ -0,0 +1,213 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 Centre Tecnologic de Telecomunicacions de Catalunya (CTTC)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Giuseppe Piro  <g.piro@poliba.it>
+ *         Marco Miozzo <mmiozzo@cttc.es>
+ */
+
+
+#ifndef TRACE_FADING_LOSS_MODEL_H
+#define TRACE_FADING_LOSS_MODEL_H
+
+
+#include <ns3/object.h>
+#include <ns3/assert.h>
+#include <ns3/simple-ref-count.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <map>
+#include <vector>
+#include "ns3/random-variable-stream.h"
+#include <ns3/nstime.h>
+
+namespace ns3 {
+
+
+class MobilityModel;
+
+
+/**
+ * \ingroup lte
+ *
+ * \brief the samples of a fading trace file, loaded once and shared by all
+ * the TraceFadingLossModel instances which use the same file.
+ *
+ * The file is either in the ASCII format produced by the fading trace
+ * generator (one row per RB), or in the binary format written by
+ * TraceFadingLossModel::ConvertTrace, which is memory-mapped read-only
+ * where mmap is available.
+ */
+class FadingTrace : public SimpleRefCount<FadingTrace>
+{
+public:
+  ~FadingTrace ();
+
+  /**
+   * \brief Get the trace loaded from a file, loading it if needed
+   * \param fileName the name of the trace file
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB
+   * \return the trace
+   */
+  static Ptr<const FadingTrace> Get (std::string fileName, uint8_t rbNum, uint32_t samplesNum);
+
+  /**
+   * \param rb the RB
+   * \param sample the sample index
+   * \return the fading (dB) of the RB at the sample
+   */
+  double GetValue (uint32_t rb, uint32_t sample) const
+  {
+    NS_ASSERT (rb < m_rbNum && sample < m_samplesNum);
+    return m_samples[rb * m_samplesNum + sample];
+  }
+
+private:
+  /**
+   * \param key the key of the trace in the list of loaded traces
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB
+   */
+  FadingTrace (std::string key, uint8_t rbNum, uint32_t samplesNum);
+  /**
+   * \brief Map or read a trace file in the binary format
+   * \param fileName the name of the trace file
+   * \return false if the file is not in the binary format
+   */
+  bool LoadBinary (std::string fileName);
+  /**
+   * \brief Read a trace file in the ASCII format
+   * \param fileName the name of the trace file
+   */
+  void LoadAscii (std::string fileName);
+
+  std::string m_key;              ///< key in the list of loaded traces
+  uint8_t m_rbNum;                ///< number of RBs
+  uint32_t m_samplesNum;          ///< number of samples per RB
+  const double *m_samples;        ///< the samples, RB after RB
+  std::vector<double> m_storage;  ///< the samples, when they are not mapped
+  void *m_mapping;                ///< the mapped file, if any
+  size_t m_mappingSize;           ///< the size of the mapped file
+};
+
+
+/**
+ * \ingroup lte
+ *
+ * \brief fading loss model based on precalculated fading traces
+ */
+class TraceFadingLossModel : public SpectrumPropagationLossModel
+{
+public:
+  TraceFadingLossModel ();
+  virtual ~TraceFadingLossModel ();
+
+  static TypeId GetTypeId ();
+  
+  virtual void DoInitialize (void);
+  virtual void DoDispose (void);
+
+  /**
+   * \brief The couple of mobility mnode that form a fading channel realization
+   */
+  typedef std::pair<Ptr<const MobilityModel>, Ptr<const MobilityModel> > ChannelRealizationId_t;
+
+ /**
+  * Assign a fixed random variable stream number to the random variables
+  * used by this model.  Return the number of streams (possibly zero) that
+  * have been assigned.
+  *
+  * \param stream first stream index to use
+  * \return the number of stream indices assigned by this model
+  */
+  int64_t AssignStreams (int64_t stream);
+
+  /**
+   * \brief Convert a fading trace from the ASCII to the binary format
+   *
+   * Traces in the binary format are loaded without parsing, and shared
+   * through a read-only memory mapping where available.
+   *
+   * \param asciiFileName the name of the ASCII trace file
+   * \param binaryFileName the name of the binary trace file to write
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB
+   */
+  static void ConvertTrace (std::string asciiFileName, std::string binaryFileName,
+                            uint8_t rbNum, uint32_t samplesNum);
+
+private:
+  /**
+   * \param txPsd set of values vs frequency representing the
+   *              transmission power. See SpectrumChannel for details.
+   * \param a sender mobility
+   * \param b receiver mobility
+   * \return set of values vs frequency representing the received
+   *         power in the same units used for the txPsd parameter.
+   */
+  Ptr<SpectrumValue> DoCalcRxPowerSpectralDensity (Ptr<const SpectrumValue> txPsd,
+                                                   Ptr<const MobilityModel> a,
+                                                   Ptr<const MobilityModel> b) const;
+                                                   
+  /**
+  * \brief Get the value for a particular sub channel and a given speed
+  * \param subChannel the sub channel for which a value is requested
+  * \param speed the relative speed of the two devices
+  * \return the loss for a particular sub channel
+  */
+  double GetValue (int subChannel, double speed);
+  
+  void SetTraceFileName (std::string fileName);
+  void SetTraceLength (Time t);
+  
+  void LoadTrace ();
+
+
+  /**
+   * \brief The window of a channel realization in the trace
+   */
+  struct ChannelRealization
+  {
+    int windowOffset;                    ///< start of the window (ms)
+    Ptr<UniformRandomVariable> startVariable; ///< draws the window start
+  };
+
+  /// the channel realizations
+  mutable std::map <ChannelRealizationId_t, ChannelRealization> m_channelRealizations;
+
+  std::string m_traceFile;
+
+  /// the fading samples, shared with the other models using the same file
+  Ptr<const FadingTrace> m_fadingTrace;
+
+  Time m_traceLength;
+  uint32_t m_samplesNum;
+  Time m_windowSize;
+  uint8_t m_rbNum;
+  mutable Time m_lastWindowUpdate;
+  uint8_t m_timeGranularity;
+  mutable uint64_t m_currentStream;
+  mutable uint64_t m_lastStream;
+  uint64_t m_streamSetSize;
+  mutable bool m_streamsAssigned;
+  
+};
+
+
+
+} // namespace ns3
+
+#endif /* TRACE_FADING_LOSS_MODEL_H */
@@ -26,7 +26,6 @@
  *          Pavel Boyko <boyko@iitp.ru>
  */
 #include "aodv-id-cache.h"
-#include <algorithm>
 
 namespace ns3
 {
@@ -36,20 +35,24 @@ bool
 IdCache::IsDuplicate (Ipv4Address addr, uint32_t id)
 {
   Purge ();
-  for (std::vector<UniqueId>::const_iterator i = m_idCache.begin ();
-       i != m_idCache.end (); ++i)
-    if (i->m_context == addr && i->m_id == id)
-      return true;
-  struct UniqueId uniqueId =
-  { addr, id, m_lifetime + Simulator::Now () };
-  m_idCache.push_back (uniqueId);
+  UniqueId uniqueId (addr, id);
+  if (m_idCache.find (uniqueId) != m_idCache.end ())
+    return true;
+  Time expire = m_lifetime + Simulator::Now ();
+  m_idCache.insert (std::make_pair (uniqueId, expire));
+  m_expirations.insert (std::make_pair (expire, uniqueId));
   return false;
 }
 void
 IdCache::Purge ()
 {
-  m_idCache.erase (remove_if (m_idCache.begin (), m_idCache.end (),
-                              IsExpired ()), m_idCache.end ());
+  // only the records which expired are visited
+  while (!m_expirations.empty ()
+         && m_expirations.begin ()->first < Simulator::Now ())
+    {
+      m_idCache.erase (m_expirations.begin ()->second);
+      m_expirations.erase (m_expirations.begin ());
+    }
 }
 
 uint32_t
@@ -31,7 +31,8 @@
 
 #include "ns3/ipv4-address.h"
 #include "ns3/simulator.h"
-#include <vector>
+#include <map>
+#include <utility>
 
 namespace ns3
 {
@@ -58,25 +59,12 @@ public:
   /// Return lifetime for existing entries in cache
   Time GetLifeTime () const { return m_lifetime; }
 private:
-  /// Unique packet ID
-  struct UniqueId
-  {
-    /// ID is supposed to be unique in single address context (e.g. sender address)
-    Ipv4Address m_context;
-    /// The id
-    uint32_t m_id;
-    /// When record will expire
-    Time m_expire;
-  };
-  struct IsExpired
-  {
-    bool operator() (const struct UniqueId & u) const
-    {
-      return (u.m_expire < Simulator::Now ());
-    }
-  };
-  /// Already seen IDs
-  std::vector<UniqueId> m_idCache;
+  /// Unique packet ID: the ID is supposed to be unique in single address context (e.g. sender address)
+  typedef std::pair<Ipv4Address, uint32_t> UniqueId;
+  /// Already seen IDs, with the time when the record will expire
+  std::map<UniqueId, Time> m_idCache;
+  /// Already seen IDs, by expiration time
+  std::multimap<Time, UniqueId> m_expirations;
   /// Default lifetime for ID records
   Time m_lifetime;
 };
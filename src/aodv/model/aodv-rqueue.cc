@@ -27,7 +27,7 @@
  */
 #include "aodv-rqueue.h"
 #include <algorithm>
-#include <functional>
+#include <vector>
 #include "ns3/ipv4-route.h"
 #include "ns3/socket.h"
 #include "ns3/log.h"
@@ -43,99 +43,153 @@ uint32_t
 RequestQueue::GetSize ()
 {
   Purge ();
-  return m_queue.size ();
+  return m_size;
 }
 
 bool
 RequestQueue::Enqueue (QueueEntry & entry)
 {
   Purge ();
-  for (std::vector<QueueEntry>::const_iterator i = m_queue.begin (); i
-       != m_queue.end (); ++i)
+  Ipv4Address dst = entry.GetIpv4Header ().GetDestination ();
+  std::map<Ipv4Address, DestinationQueue>::const_iterator queue = m_queue.find (dst);
+  if (queue != m_queue.end ())
     {
-      if ((i->GetPacket ()->GetUid () == entry.GetPacket ()->GetUid ())
-          && (i->GetIpv4Header ().GetDestination ()
-              == entry.GetIpv4Header ().GetDestination ()))
-        return false;
+      for (DestinationQueue::const_iterator i = queue->second.begin (); i
+           != queue->second.end (); ++i)
+        {
+          if (i->second.GetPacket ()->GetUid () == entry.GetPacket ()->GetUid ())
+            return false;
+        }
     }
   entry.SetExpireTime (m_queueTimeout);
-  if (m_queue.size () == m_maxLen)
+  if (m_size == m_maxLen)
     {
-      Drop (m_queue.front (), "Drop the most aged packet"); // Drop the most aged packet
-      m_queue.erase (m_queue.begin ());
+      DropEarliest (); // Drop the most aged packet
     }
-  m_queue.push_back (entry);
+  m_queue[dst].push_back (std::make_pair (m_nextIndex++, entry));
+  m_size++;
+  m_nextExpire = std::min (m_nextExpire, Simulator::Now () + entry.GetExpireTime ());
   return true;
 }
 
 void
-RequestQueue::DropPacketWithDst (Ipv4Address dst)
+RequestQueue::DropEarliest ()
 {
-  NS_LOG_FUNCTION (this << dst);
-  Purge ();
-  for (std::vector<QueueEntry>::iterator i = m_queue.begin (); i
+  // the earliest entry is the first one of one of the destinations
+  std::map<Ipv4Address, DestinationQueue>::iterator earliest = m_queue.end ();
+  for (std::map<Ipv4Address, DestinationQueue>::iterator i = m_queue.begin (); i
        != m_queue.end (); ++i)
     {
-      if (IsEqual (*i, dst))
+      if (earliest == m_queue.end ()
+          || i->second.front ().first < earliest->second.front ().first)
         {
-          Drop (*i, "DropPacketWithDst ");
+          earliest = i;
         }
     }
-  m_queue.erase (std::remove_if (m_queue.begin (), m_queue.end (),
-                                 std::bind2nd (std::ptr_fun (RequestQueue::IsEqual), dst)), m_queue.end ());
+  if (earliest == m_queue.end ())
+    {
+      return;
+    }
+  QueueEntry entry = earliest->second.front ().second;
+  earliest->second.pop_front ();
+  if (earliest->second.empty ())
+    {
+      m_queue.erase (earliest);
+    }
+  m_size--;
+  Drop (entry, "Drop the most aged packet");
 }
 
-bool
-RequestQueue::Dequeue (Ipv4Address dst, QueueEntry & entry)
+void
+RequestQueue::DropPacketWithDst (Ipv4Address dst)
 {
+  NS_LOG_FUNCTION (this << dst);
   Purge ();
-  for (std::vector<QueueEntry>::iterator i = m_queue.begin (); i != m_queue.end (); ++i)
+  std::map<Ipv4Address, DestinationQueue>::iterator queue = m_queue.find (dst);
+  if (queue == m_queue.end ())
     {
-      if (i->GetIpv4Header ().GetDestination () == dst)
-        {
-          entry = *i;
-          m_queue.erase (i);
-          return true;
-        }
+      return;
+    }
+  DestinationQueue dropped;
+  dropped.swap (queue->second);
+  m_queue.erase (queue);
+  m_size -= dropped.size ();
+  for (DestinationQueue::const_iterator i = dropped.begin (); i
+       != dropped.end (); ++i)
+    {
+      Drop (i->second, "DropPacketWithDst ");
     }
-  return false;
 }
 
 bool
-RequestQueue::Find (Ipv4Address dst)
+RequestQueue::Dequeue (Ipv4Address dst, QueueEntry & entry)
 {
-  for (std::vector<QueueEntry>::const_iterator i = m_queue.begin (); i
-       != m_queue.end (); ++i)
+  Purge ();
+  std::map<Ipv4Address, DestinationQueue>::iterator queue = m_queue.find (dst);
+  if (queue == m_queue.end ())
+    {
+      return false;
+    }
+  entry = queue->second.front ().second;
+  queue->second.pop_front ();
+  if (queue->second.empty ())
     {
-      if (i->GetIpv4Header ().GetDestination () == dst)
-        return true;
+      m_queue.erase (queue);
     }
-  return false;
+  m_size--;
+  return true;
 }
 
-struct IsExpired
+bool
+RequestQueue::Find (Ipv4Address dst)
 {
-  bool
-  operator() (QueueEntry const & e) const
-  {
-    return (e.GetExpireTime () < Seconds (0));
-  }
-};
+  return m_queue.find (dst) != m_queue.end ();
+}
 
 void
 RequestQueue::Purge ()
 {
-  IsExpired pred;
-  for (std::vector<QueueEntry>::iterator i = m_queue.begin (); i
-       != m_queue.end (); ++i)
+  if (m_size == 0 || m_nextExpire >= Simulator::Now ())
+    {
+      return;
+    }
+  m_nextExpire = Time::Max ();
+  std::vector<std::pair<uint64_t, QueueEntry> > expired;
+  for (std::map<Ipv4Address, DestinationQueue>::iterator queue = m_queue.begin (); queue
+       != m_queue.end (); )
     {
-      if (pred (*i))
+      DestinationQueue kept;
+      for (DestinationQueue::const_iterator i = queue->second.begin (); i
+           != queue->second.end (); ++i)
+        {
+          if (i->second.GetExpireTime () < Seconds (0))
+            {
+              expired.push_back (*i);
+            }
+          else
+            {
+              kept.push_back (*i);
+              m_nextExpire = std::min (m_nextExpire, Simulator::Now () + i->second.GetExpireTime ());
+            }
+        }
+      if (kept.empty ())
         {
-          Drop (*i, "Drop outdated packet ");
+          m_queue.erase (queue++);
         }
+      else
+        {
+          queue->second.swap (kept);
+          ++queue;
+        }
+    }
+  m_size -= expired.size ();
+  // drop the packets in the order they were queued
+  std::sort (expired.begin (), expired.end (), RankLess);
+  for (std::vector<std::pair<uint64_t, QueueEntry> >::const_iterator i = expired.begin (); i
+       != expired.end (); ++i)
+    {
+      Drop (i->second, "Drop outdated packet ");
     }
-  m_queue.erase (std::remove_if (m_queue.begin (), m_queue.end (), pred),
-                 m_queue.end ());
 }
 
 void
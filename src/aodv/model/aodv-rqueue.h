@@ -28,7 +28,9 @@
 #ifndef AODV_RQUEUE_H
 #define AODV_RQUEUE_H
 
-#include <vector>
+#include <deque>
+#include <map>
+#include <utility>
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/simulator.h"
 
@@ -98,6 +100,7 @@ class RequestQueue
 public:
   /// Default c-tor
   RequestQueue (uint32_t maxLen, Time routeToQueueTimeout) :
+    m_size (0), m_nextIndex (0), m_nextExpire (Time::Max ()),
     m_maxLen (maxLen), m_queueTimeout (routeToQueueTimeout)
   {
   }
@@ -120,16 +123,28 @@ public:
 
 private:
   
-  std::vector<QueueEntry> m_queue;
+  /// Entries for one destination, with their rank in the whole queue, earliest first
+  typedef std::deque<std::pair<uint64_t, QueueEntry> > DestinationQueue;
+  /// Entries for each destination with at least one entry
+  std::map<Ipv4Address, DestinationQueue> m_queue;
+  /// Number of entries
+  uint32_t m_size;
+  /// Rank of the next queued entry
+  uint64_t m_nextIndex;
+  /// No entry expires before this time, so that Purge has nothing to do until then
+  Time m_nextExpire;
   /// Remove all expired entries
   void Purge ();
+  /// Remove the earliest entry of the whole queue
+  void DropEarliest ();
   /// Notify that packet is dropped from queue by timeout
   void Drop (QueueEntry en, std::string reason);
+  /// Compare the rank of two entries
+  static bool RankLess (std::pair<uint64_t, QueueEntry> const & a, std::pair<uint64_t, QueueEntry> const & b) { return a.first < b.first; }
   /// The maximum number of packets that we allow a routing protocol to buffer.
   uint32_t m_maxLen;
   /// The maximum period of time that a routing protocol is allowed to buffer a packet for, seconds.
   Time m_queueTimeout;
-  static bool IsEqual (QueueEntry en, const Ipv4Address dst) { return (en.GetIpv4Header ().GetDestination () == dst); }
 };
 
 
@@ -192,7 +192,8 @@ RoutingTableEntry::Print (Ptr<OutputStreamWrapper> stream) const
  */
 
 RoutingTable::RoutingTable (Time t) : 
-  m_badLinkLifetime (t)
+  m_badLinkLifetime (t),
+  m_nextPurge (Time::Max ())
 {
 }
 
@@ -254,6 +255,10 @@ RoutingTable::AddRoute (RoutingTableEntry & rt)
     rt.SetRreqCnt (0);
   std::pair<std::map<Ipv4Address, RoutingTableEntry>::iterator, bool> result =
     m_ipv4AddressEntry.insert (std::make_pair (rt.GetDestination (), rt));
+  if (result.second)
+    {
+      UpdateNextPurge (rt);
+    }
   return result.second;
 }
 
@@ -274,6 +279,7 @@ RoutingTable::Update (RoutingTableEntry & rt)
       NS_LOG_LOGIC ("Route update to " << rt.GetDestination () << " set RreqCnt to 0");
       i->second.SetRreqCnt (0);
     }
+  UpdateNextPurge (i->second);
   return true;
 }
 
@@ -290,6 +296,7 @@ RoutingTable::SetEntryState (Ipv4Address id, RouteFlags state)
     }
   i->second.SetFlag (state);
   i->second.SetRreqCnt (0);
+  UpdateNextPurge (i->second);
   NS_LOG_LOGIC ("Route set entry state to " << id << ": new state is " << state);
   return true;
 }
@@ -316,17 +323,16 @@ RoutingTable::InvalidateRoutesWithDst (const std::map<Ipv4Address, uint32_t> & u
 {
   NS_LOG_FUNCTION (this);
   Purge ();
-  for (std::map<Ipv4Address, RoutingTableEntry>::iterator i =
-         m_ipv4AddressEntry.begin (); i != m_ipv4AddressEntry.end (); ++i)
+  for (std::map<Ipv4Address, uint32_t>::const_iterator j =
+         unreachable.begin (); j != unreachable.end (); ++j)
     {
-      for (std::map<Ipv4Address, uint32_t>::const_iterator j =
-             unreachable.begin (); j != unreachable.end (); ++j)
+      std::map<Ipv4Address, RoutingTableEntry>::iterator i =
+        m_ipv4AddressEntry.find (j->first);
+      if ((i != m_ipv4AddressEntry.end ()) && (i->second.GetFlag () == VALID))
         {
-          if ((i->first == j->first) && (i->second.GetFlag () == VALID))
-            {
-              NS_LOG_LOGIC ("Invalidate route with destination address " << i->first);
-              i->second.Invalidate (m_badLinkLifetime);
-            }
+          NS_LOG_LOGIC ("Invalidate route with destination address " << i->first);
+          i->second.Invalidate (m_badLinkLifetime);
+          UpdateNextPurge (i->second);
         }
     }
 }
@@ -355,8 +361,9 @@ void
 RoutingTable::Purge ()
 {
   NS_LOG_FUNCTION (this);
-  if (m_ipv4AddressEntry.empty ())
+  if (m_ipv4AddressEntry.empty () || m_nextPurge >= Simulator::Now ())
     return;
+  m_nextPurge = Time::Max ();
   for (std::map<Ipv4Address, RoutingTableEntry>::iterator i =
          m_ipv4AddressEntry.begin (); i != m_ipv4AddressEntry.end ();)
     {
@@ -372,6 +379,7 @@ RoutingTable::Purge ()
             {
               NS_LOG_LOGIC ("Invalidate route with destination address " << i->first);
               i->second.Invalidate (m_badLinkLifetime);
+              UpdateNextPurge (i->second);
               ++i;
             }
           else
@@ -379,11 +387,22 @@ RoutingTable::Purge ()
         }
       else 
         {
+          UpdateNextPurge (i->second);
           ++i;
         }
     }
 }
 
+void
+RoutingTable::UpdateNextPurge (const RoutingTableEntry & rt)
+{
+  // the lifetime of the entries in search of a route does not matter
+  if (rt.GetFlag () != IN_SEARCH)
+    {
+      m_nextPurge = std::min (m_nextPurge, Simulator::Now () + rt.GetLifeTime ());
+    }
+}
+
 void
 RoutingTable::Purge (std::map<Ipv4Address, RoutingTableEntry> &table) const
 {
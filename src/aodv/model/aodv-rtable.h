@@ -232,7 +232,7 @@ public:
   /// Delete all route from interface with address iface
   void DeleteAllRoutesFromInterface (Ipv4InterfaceAddress iface);
   /// Delete all entries from routing table
-  void Clear () { m_ipv4AddressEntry.clear (); }
+  void Clear () { m_ipv4AddressEntry.clear (); m_nextPurge = Time::Max (); }
   /// Delete all outdated entries and invalidate valid entry if Lifetime is expired
   void Purge ();
   /** Mark entry as unidirectional (e.g. add this neighbor to "blacklist" for blacklistTimeout period)
@@ -248,6 +248,10 @@ private:
   std::map<Ipv4Address, RoutingTableEntry> m_ipv4AddressEntry;
   /// Deletion time for invalid routes
   Time m_badLinkLifetime;
+  /// No entry expires before this time, so that Purge has nothing to do until then
+  Time m_nextPurge;
+  /// Take into account the lifetime of a new or modified entry in m_nextPurge
+  void UpdateNextPurge (const RoutingTableEntry & rt);
   /// const version of Purge, for use by Print() method
   void Purge (std::map<Ipv4Address, RoutingTableEntry> &table) const;
 };
@@ -380,6 +380,26 @@ AodvRqueueTest::CheckSizeLimit ()
   for (uint32_t i = 0; i < q.GetMaxQueueLen (); ++i)
     q.Enqueue (e1);
   NS_TEST_EXPECT_MSG_EQ (q.GetSize (), 2, "trivial");
+
+  // The most aged packet is dropped from a full queue, whatever its destination
+  RequestQueue full (2, Seconds (30));
+  Ipv4Header h1, h2;
+  h1.SetDestination (Ipv4Address ("1.1.1.1"));
+  h2.SetDestination (Ipv4Address ("2.2.2.2"));
+  QueueEntry a (Create<Packet> (), h1, ucb, ecb);
+  QueueEntry b (Create<Packet> (), h2, ucb, ecb);
+  QueueEntry c (Create<Packet> (), h2, ucb, ecb);
+  full.Enqueue (a);
+  full.Enqueue (b);
+  full.Enqueue (c);
+  NS_TEST_EXPECT_MSG_EQ (full.GetSize (), 2, "trivial");
+  NS_TEST_EXPECT_MSG_EQ (full.Find (Ipv4Address ("1.1.1.1")), false, "The most aged packet must be dropped");
+  QueueEntry out;
+  NS_TEST_EXPECT_MSG_EQ (full.Dequeue (Ipv4Address ("2.2.2.2"), out), true, "trivial");
+  NS_TEST_EXPECT_MSG_EQ (out.GetPacket (), b.GetPacket (), "Packets must be dequeued in order");
+  NS_TEST_EXPECT_MSG_EQ (full.Dequeue (Ipv4Address ("2.2.2.2"), out), true, "trivial");
+  NS_TEST_EXPECT_MSG_EQ (out.GetPacket (), c.GetPacket (), "Packets must be dequeued in order");
+  NS_TEST_EXPECT_MSG_EQ (full.GetSize (), 0, "trivial");
 }
 
 void
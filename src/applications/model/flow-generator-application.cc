@@ -0,0 +1,409 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "ns3/log.h"
+#include "ns3/address.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/node.h"
+#include "ns3/socket.h"
+#include "ns3/simulator.h"
+#include "ns3/socket-factory.h"
+#include "ns3/packet.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/pointer.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/tcp-socket-factory.h"
+#include "flow-generator-application.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FlowGeneratorApplication");
+
+NS_OBJECT_ENSURE_REGISTERED (FlowGeneratorApplication);
+
+/// number of bins of the histogram of the flow completion times
+static const uint32_t FCT_HISTOGRAM_BINS = 48;
+
+TypeId
+FlowGeneratorApplication::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FlowGeneratorApplication")
+    .SetParent<Application> ()
+    .SetGroupName ("Applications")
+    .AddConstructor<FlowGeneratorApplication> ()
+    .AddAttribute ("SendSize", "The amount of data to send each time.",
+                   UintegerValue (512),
+                   MakeUintegerAccessor (&FlowGeneratorApplication::m_sendSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("Remote", "The address of the destination",
+                   AddressValue (),
+                   MakeAddressAccessor (&FlowGeneratorApplication::m_peer),
+                   MakeAddressChecker ())
+    .AddAttribute ("Protocol", "The type of protocol to use.",
+                   TypeIdValue (TcpSocketFactory::GetTypeId ()),
+                   MakeTypeIdAccessor (&FlowGeneratorApplication::m_tid),
+                   MakeTypeIdChecker ())
+    .AddAttribute ("InterArrivalTime",
+                   "A RandomVariableStream used to pick the time (s) between two flow arrivals.",
+                   StringValue ("ns3::ExponentialRandomVariable[Mean=0.01]"),
+                   MakePointerAccessor (&FlowGeneratorApplication::m_interArrival),
+                   MakePointerChecker <RandomVariableStream>())
+    .AddAttribute ("FlowSize",
+                   "A RandomVariableStream used to pick the size (bytes) of the flows.",
+                   StringValue ("ns3::ConstantRandomVariable[Constant=10000]"),
+                   MakePointerAccessor (&FlowGeneratorApplication::m_flowSize),
+                   MakePointerChecker <RandomVariableStream>())
+    .AddAttribute ("MaxConnections",
+                   "The largest number of connections opened to the destination, "
+                   "i.e. of flows sent at the same time.",
+                   UintegerValue (16),
+                   MakeUintegerAccessor (&FlowGeneratorApplication::m_maxConnections),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("MaxFlows",
+                   "The total number of flows to generate. "
+                   "The value zero means that there is no limit.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&FlowGeneratorApplication::m_maxFlows),
+                   MakeUintegerChecker<uint64_t> ())
+    .AddAttribute ("FctResolution",
+                   "The width of the first bin of the histogram of the flow "
+                   "completion times; each other bin is twice as wide as the previous one.",
+                   TimeValue (MicroSeconds (1)),
+                   MakeTimeAccessor (&FlowGeneratorApplication::m_fctResolution),
+                   MakeTimeChecker (TimeStep (1)))
+    .AddTraceSource ("Tx", "A new packet is created and is sent",
+                     MakeTraceSourceAccessor (&FlowGeneratorApplication::m_txTrace),
+                     "ns3::Packet::TracedCallback")
+    .AddTraceSource ("FlowCompleted", "A flow has been completely acknowledged",
+                     MakeTraceSourceAccessor (&FlowGeneratorApplication::m_flowCompletedTrace),
+                     "ns3::FlowGeneratorApplication::FlowCompletedCallback")
+  ;
+  return tid;
+}
+
+
+FlowGeneratorApplication::FlowGeneratorApplication ()
+  : m_startedFlows (0),
+    m_completedFlows (0),
+    m_totalFct (Seconds (0)),
+    m_fctHistogram (FCT_HISTOGRAM_BINS, 0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+FlowGeneratorApplication::~FlowGeneratorApplication ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint64_t
+FlowGeneratorApplication::GetStartedFlows (void) const
+{
+  return m_startedFlows;
+}
+
+uint64_t
+FlowGeneratorApplication::GetCompletedFlows (void) const
+{
+  return m_completedFlows;
+}
+
+uint32_t
+FlowGeneratorApplication::GetWaitingFlows (void) const
+{
+  return m_waiting.size ();
+}
+
+uint32_t
+FlowGeneratorApplication::GetNConnections (void) const
+{
+  return m_connections.size ();
+}
+
+Time
+FlowGeneratorApplication::GetMeanFct (void) const
+{
+  if (m_completedFlows == 0)
+    {
+      return Seconds (0);
+    }
+  return m_totalFct / static_cast<int64_t> (m_completedFlows);
+}
+
+const std::vector<uint64_t> &
+FlowGeneratorApplication::GetFctHistogram (void) const
+{
+  return m_fctHistogram;
+}
+
+int64_t
+FlowGeneratorApplication::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  m_interArrival->SetStream (stream);
+  m_flowSize->SetStream (stream + 1);
+  return 2;
+}
+
+void
+FlowGeneratorApplication::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_connections.clear ();
+  m_idle.clear ();
+  m_waiting.clear ();
+  // chain up
+  Application::DoDispose ();
+}
+
+// Application Methods
+void FlowGeneratorApplication::StartApplication (void) // Called at time specified by Start
+{
+  NS_LOG_FUNCTION (this);
+  ScheduleNextFlow ();
+}
+
+void FlowGeneratorApplication::StopApplication (void) // Called at time specified by Stop
+{
+  NS_LOG_FUNCTION (this);
+
+  Simulator::Cancel (m_nextFlowEvent);
+  for (std::map<Ptr<Socket>, Connection>::iterator i = m_connections.begin (); i != m_connections.end (); ++i)
+    {
+      i->first->Close ();
+    }
+  m_connections.clear ();
+  m_idle.clear ();
+  if (!m_waiting.empty ())
+    {
+      NS_LOG_LOGIC ("Dropping " << m_waiting.size () << " waiting flows");
+      m_waiting.clear ();
+    }
+}
+
+
+// Private helpers
+
+void FlowGeneratorApplication::ScheduleNextFlow (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_maxFlows == 0 || m_startedFlows < m_maxFlows)
+    {
+      Time next = Seconds (m_interArrival->GetValue ());
+      NS_LOG_LOGIC ("next flow in " << next.GetSeconds () << " sec");
+      m_nextFlowEvent = Simulator::Schedule (next, &FlowGeneratorApplication::StartFlow, this);
+    }
+}
+
+void FlowGeneratorApplication::StartFlow (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  Flow flow;
+  flow.arrival = Simulator::Now ();
+  flow.size = std::max (1u, static_cast<uint32_t> (std::floor (m_flowSize->GetValue () + 0.5)));
+  NS_LOG_LOGIC ("flow " << m_startedFlows << " of " << flow.size << " bytes");
+  m_startedFlows++;
+  m_waiting.push_back (flow);
+
+  if (!m_idle.empty ())
+    {
+      Ptr<Socket> socket = m_idle.back ();
+      m_idle.pop_back ();
+      Connection &connection = m_connections[socket];
+      NextFlow (socket, connection);
+      SendData (socket, connection);
+    }
+  else if (m_connections.size () < m_maxConnections)
+    {
+      OpenConnection ();
+    }
+  ScheduleNextFlow ();
+}
+
+void FlowGeneratorApplication::OpenConnection (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<Socket> socket = Socket::CreateSocket (GetNode (), m_tid);
+  Connection &connection = m_connections[socket];
+  connection.connected = false;
+  connection.busy = false;
+  connection.sending = false;
+  connection.sent = 0;
+  connection.txSpace = 0;
+
+  if (Inet6SocketAddress::IsMatchingType (m_peer))
+    {
+      socket->Bind6 ();
+    }
+  else if (InetSocketAddress::IsMatchingType (m_peer))
+    {
+      socket->Bind ();
+    }
+
+  socket->SetConnectCallback (
+    MakeCallback (&FlowGeneratorApplication::ConnectionSucceeded, this),
+    MakeCallback (&FlowGeneratorApplication::ConnectionFailed, this));
+  socket->SetSendCallback (
+    MakeCallback (&FlowGeneratorApplication::DataSend, this));
+  socket->SetCloseCallbacks (
+    MakeCallback (&FlowGeneratorApplication::ConnectionClosed, this),
+    MakeCallback (&FlowGeneratorApplication::ConnectionClosed, this));
+  socket->Connect (m_peer);
+  socket->ShutdownRecv ();
+}
+
+void FlowGeneratorApplication::NextFlow (Ptr<Socket> socket, Connection &connection)
+{
+  NS_LOG_FUNCTION (this << socket);
+
+  if (m_waiting.empty ())
+    {
+      connection.busy = false;
+      m_idle.push_back (socket);
+      return;
+    }
+  connection.busy = true;
+  connection.flow = m_waiting.front ();
+  connection.sent = 0;
+  m_waiting.pop_front ();
+}
+
+void FlowGeneratorApplication::SendData (Ptr<Socket> socket, Connection &connection)
+{
+  NS_LOG_FUNCTION (this << socket);
+
+  // datagram sockets notify the available space from within Send
+  if (connection.sending)
+    {
+      return;
+    }
+  connection.sending = true;
+  while (connection.busy)
+    {
+      while (connection.sent < connection.flow.size)
+        {
+          uint32_t toSend = std::min (m_sendSize, connection.flow.size - connection.sent);
+          Ptr<Packet> packet = Create<Packet> (toSend);
+          int actual = socket->Send (packet);
+          if (actual > 0)
+            {
+              m_txTrace (packet);
+              connection.sent += actual;
+            }
+          // We exit when actual < toSend as the send side buffer is full.
+          // The "DataSent" callback will pop when some buffer space has
+          // freed up.
+          if ((unsigned)actual != toSend)
+            {
+              connection.sending = false;
+              return;
+            }
+        }
+      // the flow is complete once the transmission buffer is empty again,
+      // i.e. all its bytes have been acknowledged
+      if (socket->GetTxAvailable () < connection.txSpace)
+        {
+          break;
+        }
+      CompleteFlow (connection.flow);
+      NextFlow (socket, connection);
+    }
+  connection.sending = false;
+}
+
+void FlowGeneratorApplication::CompleteFlow (const Flow &flow)
+{
+  Time fct = Simulator::Now () - flow.arrival;
+  NS_LOG_LOGIC ("flow of " << flow.size << " bytes completed in " << fct.GetSeconds () << " sec");
+  m_completedFlows++;
+  m_totalFct += fct;
+  int64_t ratio = fct.GetTimeStep () / m_fctResolution.GetTimeStep ();
+  uint32_t bin = 0;
+  while (ratio > 0 && bin + 1 < FCT_HISTOGRAM_BINS)
+    {
+      ratio >>= 1;
+      bin++;
+    }
+  m_fctHistogram[bin]++;
+  m_flowCompletedTrace (flow.size, fct);
+}
+
+void FlowGeneratorApplication::ConnectionSucceeded (Ptr<Socket> socket)
+{
+  NS_LOG_FUNCTION (this << socket);
+  NS_LOG_LOGIC ("FlowGeneratorApplication Connection succeeded");
+
+  std::map<Ptr<Socket>, Connection>::iterator it = m_connections.find (socket);
+  if (it == m_connections.end ())
+    {
+      return;
+    }
+  Connection &connection = it->second;
+  connection.connected = true;
+  connection.txSpace = socket->GetTxAvailable ();
+  NextFlow (socket, connection);
+  SendData (socket, connection);
+}
+
+void FlowGeneratorApplication::ConnectionFailed (Ptr<Socket> socket)
+{
+  NS_LOG_FUNCTION (this << socket);
+  NS_LOG_LOGIC ("FlowGeneratorApplication, Connection Failed");
+  m_connections.erase (socket);
+}
+
+void FlowGeneratorApplication::DataSend (Ptr<Socket> socket, uint32_t)
+{
+  NS_LOG_FUNCTION (this << socket);
+
+  std::map<Ptr<Socket>, Connection>::iterator it = m_connections.find (socket);
+  if (it != m_connections.end () && it->second.connected)
+    { // Only send new data if the connection has completed
+      SendData (socket, it->second);
+    }
+}
+
+void FlowGeneratorApplication::ConnectionClosed (Ptr<Socket> socket)
+{
+  NS_LOG_FUNCTION (this << socket);
+
+  std::map<Ptr<Socket>, Connection>::iterator it = m_connections.find (socket);
+  if (it == m_connections.end ())
+    {
+      return;
+    }
+  if (it->second.busy)
+    {
+      NS_LOG_WARN ("Connection closed before the end of a flow of " << it->second.flow.size << " bytes");
+    }
+  std::vector<Ptr<Socket> >::iterator idle = std::find (m_idle.begin (), m_idle.end (), socket);
+  if (idle != m_idle.end ())
+    {
+      m_idle.erase (idle);
+    }
+  m_connections.erase (it);
+}
+
+} // Namespace ns3
@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FLOW_GENERATOR_APPLICATION_H
+#define FLOW_GENERATOR_APPLICATION_H
+
+#include <deque>
+#include <map>
+#include <vector>
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3 {
+
+class Socket;
+class RandomVariableStream;
+
+/**
+ * \ingroup applications
+ * \defgroup flowgenerator FlowGeneratorApplication
+ *
+ * This traffic generator opens a sequence of finite flows towards
+ * a remote address, such as the short flows of a data center or web
+ * workload, with a single application per node.
+ */
+
+/**
+ * \ingroup flowgenerator
+ *
+ * \brief Generate finite flows whose arrivals and sizes are drawn from
+ * random variables, over a bounded pool of persistent connections.
+ *
+ * The time between two flow arrivals is drawn from the InterArrivalTime
+ * random variable (in seconds) and the size of each flow from the FlowSize
+ * random variable (in bytes); an empirical distribution of the flow sizes
+ * can be given with an ns3::EmpiricalRandomVariable.
+ *
+ * The flows are not given a socket each: they are sent one after the other
+ * over a pool of at most MaxConnections persistent connections to the
+ * Remote address, which are opened as needed. A flow is assigned to an idle
+ * connection, or waits in a FIFO queue until one becomes idle. A flow is
+ * complete when all its bytes are acknowledged, i.e. when the transmission
+ * buffer of its connection is empty again; the connection then takes the
+ * next waiting flow. The flow completion time includes the time spent in
+ * the queue.
+ *
+ * Only the waiting and active flows are kept in memory. The completion
+ * times are reported through the FlowCompleted trace source, and summed up
+ * in a histogram with logarithmic bins (see GetFctHistogram), so that
+ * millions of flows can be generated in a simulation.
+ *
+ * The application is meant for SOCK_STREAM sockets (e.g., TCP); with
+ * datagram sockets, a flow completes as soon as it has been sent.
+ */
+class FlowGeneratorApplication : public Application
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  FlowGeneratorApplication ();
+
+  virtual ~FlowGeneratorApplication ();
+
+  /**
+   * \return the number of flows generated so far
+   */
+  uint64_t GetStartedFlows (void) const;
+  /**
+   * \return the number of flows completed so far
+   */
+  uint64_t GetCompletedFlows (void) const;
+  /**
+   * \return the number of flows waiting for an idle connection
+   */
+  uint32_t GetWaitingFlows (void) const;
+  /**
+   * \return the number of connections of the pool
+   */
+  uint32_t GetNConnections (void) const;
+  /**
+   * \return the average completion time of the completed flows
+   */
+  Time GetMeanFct (void) const;
+  /**
+   * Return the histogram of the flow completion times: the value at index
+   * 0 counts the flows completed in less than FctResolution, and the value
+   * at index i > 0 the flows completed in [2^(i-1), 2^i) times
+   * FctResolution. The last bin also counts the longer flows.
+   *
+   * \return the number of completed flows in each bin
+   */
+  const std::vector<uint64_t> & GetFctHistogram (void) const;
+
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this model.  Return the number of streams (possibly zero) that
+   * have been assigned.
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
+
+  /**
+   * TracedCallback signature for completed flows.
+   *
+   * \param [in] size the size of the flow (bytes)
+   * \param [in] fct the flow completion time
+   */
+  typedef void (* FlowCompletedCallback)(uint32_t size, Time fct);
+
+protected:
+  virtual void DoDispose (void);
+private:
+  // inherited from Application base class.
+  virtual void StartApplication (void);    // Called at time specified by Start
+  virtual void StopApplication (void);     // Called at time specified by Stop
+
+  /// A flow waiting for a connection, or being sent
+  struct Flow
+  {
+    Time arrival;  //!< arrival time
+    uint32_t size; //!< size (bytes)
+  };
+  /// A connection of the pool
+  struct Connection
+  {
+    bool connected;   //!< true if connected
+    bool busy;        //!< true if sending a flow
+    bool sending;     //!< true while SendData runs on the connection
+    Flow flow;        //!< flow being sent
+    uint32_t sent;    //!< bytes of the flow given to the socket
+    uint32_t txSpace; //!< available space of the empty transmission buffer
+  };
+
+  /**
+   * \brief Schedule the arrival of the next flow.
+   */
+  void ScheduleNextFlow (void);
+  /**
+   * \brief Generate a flow and assign it to an idle connection.
+   */
+  void StartFlow (void);
+  /**
+   * \brief Open a new connection of the pool.
+   */
+  void OpenConnection (void);
+  /**
+   * \brief Give the first waiting flow to a connection, or mark it idle.
+   * \param socket the socket of the connection
+   * \param connection the connection
+   */
+  void NextFlow (Ptr<Socket> socket, Connection &connection);
+  /**
+   * \brief Send the flow of a connection until the L4 transmission buffer
+   * is full, and check whether the flow is complete.
+   * \param socket the socket of the connection
+   * \param connection the connection
+   */
+  void SendData (Ptr<Socket> socket, Connection &connection);
+  /**
+   * \brief Record the completion of a flow.
+   * \param flow the completed flow
+   */
+  void CompleteFlow (const Flow &flow);
+
+  /**
+   * \brief Connection Succeeded (called by Socket through a callback)
+   * \param socket the connected socket
+   */
+  void ConnectionSucceeded (Ptr<Socket> socket);
+  /**
+   * \brief Connection Failed (called by Socket through a callback)
+   * \param socket the connected socket
+   */
+  void ConnectionFailed (Ptr<Socket> socket);
+  /**
+   * \brief Send more data as soon as some has been transmitted.
+   * \param socket the socket
+   * \param available the available space in the transmission buffer
+   */
+  void DataSend (Ptr<Socket> socket, uint32_t available);
+  /**
+   * \brief Connection closed by the peer or with an error.
+   * \param socket the socket
+   */
+  void ConnectionClosed (Ptr<Socket> socket);
+
+  Address         m_peer;         //!< Peer address
+  TypeId          m_tid;          //!< The type of protocol to use.
+  uint32_t        m_sendSize;     //!< Size of data to send each time
+  uint32_t        m_maxConnections; //!< Size of the connection pool
+  uint64_t        m_maxFlows;     //!< Limit of the number of flows
+  Time            m_fctResolution; //!< Width of the first histogram bin
+  Ptr<RandomVariableStream> m_interArrival; //!< rng for the time between flows
+  Ptr<RandomVariableStream> m_flowSize;     //!< rng for the flow sizes
+
+  EventId         m_nextFlowEvent; //!< Event id of the next flow arrival
+  std::map<Ptr<Socket>, Connection> m_connections; //!< The connection pool
+  std::vector<Ptr<Socket> > m_idle; //!< Connected sockets without flow
+  std::deque<Flow> m_waiting;     //!< Flows waiting for a connection
+  uint64_t        m_startedFlows;   //!< Number of flows generated
+  uint64_t        m_completedFlows; //!< Number of flows completed
+  Time            m_totalFct;       //!< Sum of the flow completion times
+  std::vector<uint64_t> m_fctHistogram; //!< Histogram of the completion times
+
+  /// Traced Callback: sent packets
+  TracedCallback<Ptr<const Packet> > m_txTrace;
+  /// Traced Callback: completed flows
+  TracedCallback<uint32_t, Time> m_flowCompletedTrace;
+};
+
+} // namespace ns3
+
+#endif /* FLOW_GENERATOR_APPLICATION_H */
@@ -104,13 +104,24 @@ PacketLossCounter::SetBit (uint32_t seqNum, bool val)
  *    1.2) Mark the packet as lost (0) in the bitMap
  * 2) Mark the current packet as received (1) in the bitMap
  * 3) Update the value of the last received packet
+ * When more packets than the window are missing, step 1 stops once each
+ * bit has been visited, and the missing packets which are already out of
+ * the window are counted as lost at once.
  */
 
 void
 PacketLossCounter::NotifyReceived (uint32_t seqNum)
 {
   NS_LOG_FUNCTION (this << seqNum);
-  for (uint32_t i=m_lastMaxSeqNum+1; i<=seqNum; i++)
+  uint32_t last = seqNum;
+  uint32_t window = m_bitMapSize * 8;
+  if (seqNum > m_lastMaxSeqNum && seqNum - m_lastMaxSeqNum > window)
+    {
+      NS_LOG_INFO ("Packets lost: " << m_lastMaxSeqNum + 1 << " to " << seqNum - window);
+      m_lost += seqNum - m_lastMaxSeqNum - window;
+      last = m_lastMaxSeqNum + window;
+    }
+  for (uint32_t i=m_lastMaxSeqNum+1; i<=last; i++)
     {
       if (GetBit (i)!=1)
         {
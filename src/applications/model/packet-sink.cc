@@ -28,6 +28,7 @@
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
 #include "ns3/packet.h"
+#include "ns3/uinteger.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/udp-socket-factory.h"
 #include "packet-sink.h"
@@ -55,6 +56,12 @@ PacketSink::GetTypeId (void)
                    TypeIdValue (UdpSocketFactory::GetTypeId ()),
                    MakeTypeIdAccessor (&PacketSink::m_tid),
                    MakeTypeIdChecker ())
+    .AddAttribute ("RxTraceSampling",
+                   "The number of received packets for each packet reported "
+                   "by the Rx trace source.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&PacketSink::m_rxTraceSampling),
+                   MakeUintegerChecker<uint32_t> (1))
     .AddTraceSource ("Rx",
                      "A packet has been received",
                      MakeTraceSourceAccessor (&PacketSink::m_rxTrace),
@@ -68,6 +75,7 @@ PacketSink::PacketSink ()
   NS_LOG_FUNCTION (this);
   m_socket = 0;
   m_totalRx = 0;
+  m_totalRxPackets = 0;
 }
 
 PacketSink::~PacketSink()
@@ -95,11 +103,41 @@ PacketSink::GetAcceptedSockets (void) const
   return m_socketList;
 }
 
+uint64_t PacketSink::GetTotalRxPackets () const
+{
+  NS_LOG_FUNCTION (this);
+  return m_totalRxPackets;
+}
+
+uint32_t
+PacketSink::GetNConnections (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_connectionRx.size ();
+}
+
+uint64_t
+PacketSink::GetConnectionRx (uint32_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  NS_ASSERT (i < m_connectionRx.size ());
+  return m_connectionRx[i];
+}
+
+Address
+PacketSink::GetConnectionPeer (uint32_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  NS_ASSERT (i < m_connectionPeers.size ());
+  return m_connectionPeers[i];
+}
+
 void PacketSink::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
   m_socket = 0;
   m_socketList.clear ();
+  m_connectionIndex.clear ();
 
   // chain up
   Application::DoDispose ();
@@ -162,13 +200,16 @@ void PacketSink::HandleRead (Ptr<Socket> socket)
   NS_LOG_FUNCTION (this << socket);
   Ptr<Packet> packet;
   Address from;
+  uint64_t rxBytes = 0;
   while ((packet = socket->RecvFrom (from)))
     {
       if (packet->GetSize () == 0)
         { //EOF
           break;
         }
+      rxBytes += packet->GetSize ();
       m_totalRx += packet->GetSize ();
+      m_totalRxPackets++;
       if (InetSocketAddress::IsMatchingType (from))
         {
           NS_LOG_INFO ("At time " << Simulator::Now ().GetSeconds ()
@@ -187,7 +228,19 @@ void PacketSink::HandleRead (Ptr<Socket> socket)
                        << " port " << Inet6SocketAddress::ConvertFrom (from).GetPort ()
                        << " total Rx " << m_totalRx << " bytes");
         }
-      m_rxTrace (packet, from);
+      if (m_totalRxPackets % m_rxTraceSampling == 0)
+        {
+          m_rxTrace (packet, from);
+        }
+    }
+  // the connection counters are updated once for all the packets read
+  if (rxBytes > 0 && !m_connectionIndex.empty ())
+    {
+      std::map<Ptr<Socket>, uint32_t>::const_iterator it = m_connectionIndex.find (socket);
+      if (it != m_connectionIndex.end ())
+        {
+          m_connectionRx[it->second] += rxBytes;
+        }
     }
 }
 
@@ -208,6 +261,9 @@ void PacketSink::HandleAccept (Ptr<Socket> s, const Address& from)
   NS_LOG_FUNCTION (this << s << from);
   s->SetRecvCallback (MakeCallback (&PacketSink::HandleRead, this));
   m_socketList.push_back (s);
+  m_connectionIndex[s] = m_connectionRx.size ();
+  m_connectionRx.push_back (0);
+  m_connectionPeers.push_back (from);
 }
 
 } // Namespace ns3
@@ -26,6 +26,8 @@
 #include "ns3/ptr.h"
 #include "ns3/traced-callback.h"
 #include "ns3/address.h"
+#include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -63,7 +65,13 @@ class Packet;
  * transport protocol to use.   A virtual Receive () method is installed 
  * as a callback on the receiving socket.  By default, when logging is
  * enabled, it prints out the size of packets and their address.
- * A tracing source to Receive() is also available.
+ * A tracing source to Receive() is also available; with a RxTraceSampling
+ * attribute larger than one, it is only fired for one packet out of
+ * RxTraceSampling, so that it can be used to sample large receive rates.
+ *
+ * The bytes received on each accepted connection are counted in a flat
+ * array (see GetConnectionRx), updated once per batch of packets read
+ * from the socket.
  */
 class PacketSink : public Application 
 {
@@ -91,6 +99,28 @@ public:
    * \return list of pointers to accepted sockets
    */
   std::list<Ptr<Socket> > GetAcceptedSockets (void) const;
+
+  /**
+   * \return the total number of packets received in this sink app
+   */
+  uint64_t GetTotalRxPackets () const;
+
+  /**
+   * \return the number of connections accepted by this sink app
+   */
+  uint32_t GetNConnections (void) const;
+
+  /**
+   * \param i the index of the connection, in order of acceptance
+   * \return the bytes received on the connection
+   */
+  uint64_t GetConnectionRx (uint32_t i) const;
+
+  /**
+   * \param i the index of the connection, in order of acceptance
+   * \return the address of the peer of the connection
+   */
+  Address GetConnectionPeer (uint32_t i) const;
  
 protected:
   virtual void DoDispose (void);
@@ -128,8 +158,14 @@ private:
 
   Address         m_local;        //!< Local address to bind to
   uint64_t        m_totalRx;      //!< Total bytes received
+  uint64_t        m_totalRxPackets; //!< Total packets received
+  uint32_t        m_rxTraceSampling; //!< Packets received for each Rx trace
   TypeId          m_tid;          //!< Protocol TypeId
 
+  std::map<Ptr<Socket>, uint32_t> m_connectionIndex; //!< index of the accepted sockets
+  std::vector<uint64_t> m_connectionRx;    //!< bytes received on each connection
+  std::vector<Address> m_connectionPeers;  //!< peer of each connection
+
   /// Traced Callback: received packets, source address.
   TracedCallback<Ptr<const Packet>, const Address &> m_rxTrace;
 
@@ -29,6 +29,7 @@
 #include "ns3/socket-factory.h"
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
+#include "ns3/trace-source-accessor.h"
 #include "packet-loss-counter.h"
 
 #include "seq-ts-header.h"
@@ -59,6 +60,16 @@ UdpServer::GetTypeId (void)
                    MakeUintegerAccessor (&UdpServer::GetPacketWindowSize,
                                          &UdpServer::SetPacketWindowSize),
                    MakeUintegerChecker<uint16_t> (8,256))
+    .AddAttribute ("RxTraceSampling",
+                   "The number of received packets for each packet reported "
+                   "by the Rx trace source.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&UdpServer::m_rxTraceSampling),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddTraceSource ("Rx",
+                     "A packet has been received",
+                     MakeTraceSourceAccessor (&UdpServer::m_rxTrace),
+                     "ns3::Packet::AddressTracedCallback")
   ;
   return tid;
 }
@@ -186,6 +197,10 @@ UdpServer::HandleRead (Ptr<Socket> socket)
 
           m_lossCounter.NotifyReceived (currentSequenceNumber);
           m_received++;
+          if (m_received % m_rxTraceSampling == 0)
+            {
+              m_rxTrace (packet, from);
+            }
         }
     }
 }
@@ -27,6 +27,7 @@
 #include "ns3/event-id.h"
 #include "ns3/ptr.h"
 #include "ns3/address.h"
+#include "ns3/traced-callback.h"
 #include "packet-loss-counter.h"
 namespace ns3 {
 /**
@@ -42,6 +43,9 @@ namespace ns3 {
  * UDP packets carry a 32bits sequence number followed by a 64bits time
  * stamp in their payloads. The application uses the sequence number
  * to determine if a packet is lost, and the time stamp to compute the delay.
+ *
+ * The Rx trace source reports one received packet out of RxTraceSampling,
+ * so that large receive rates can be sampled at a low cost.
  */
 class UdpServer : public Application
 {
@@ -99,7 +103,11 @@ private:
   Ptr<Socket> m_socket; //!< IPv4 Socket
   Ptr<Socket> m_socket6; //!< IPv6 Socket
   uint64_t m_received; //!< Number of received packets
+  uint32_t m_rxTraceSampling; //!< Packets received for each Rx trace
   PacketLossCounter m_lossCounter; //!< Lost packet counter
+
+  /// Traced Callback: received packets, source address.
+  TracedCallback<Ptr<const Packet>, const Address &> m_rxTrace;
 };
 
 } // namespace ns3
@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/flow-generator-helper.h"
+#include "ns3/flow-generator-application.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simple-channel.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+
+/**
+ * Test that the flows of a FlowGeneratorApplication are all sent over
+ * the connection pool and recorded as completed.
+ */
+class FlowGeneratorTestCase : public TestCase
+{
+public:
+  FlowGeneratorTestCase ();
+  virtual ~FlowGeneratorTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Trace sink of the completed flows.
+   * \param size the size of the flow
+   * \param fct the flow completion time
+   */
+  void FlowCompleted (uint32_t size, Time fct);
+
+  uint64_t m_bytes; //!< bytes of the completed flows
+};
+
+FlowGeneratorTestCase::FlowGeneratorTestCase ()
+  : TestCase ("Test that all the flows of a FlowGeneratorApplication complete over a bounded connection pool"),
+    m_bytes (0)
+{
+}
+
+FlowGeneratorTestCase::~FlowGeneratorTestCase ()
+{
+}
+
+void
+FlowGeneratorTestCase::FlowCompleted (uint32_t size, Time fct)
+{
+  m_bytes += size;
+}
+
+void
+FlowGeneratorTestCase::DoRun (void)
+{
+  NodeContainer n;
+  n.Create (2);
+
+  InternetStackHelper internet;
+  internet.Install (n);
+
+  Ptr<SimpleNetDevice> txDev = CreateObject<SimpleNetDevice> ();
+  Ptr<SimpleNetDevice> rxDev = CreateObject<SimpleNetDevice> ();
+  txDev->SetAddress (Mac48Address::Allocate ());
+  rxDev->SetAddress (Mac48Address::Allocate ());
+  n.Get (0)->AddDevice (txDev);
+  n.Get (1)->AddDevice (rxDev);
+  Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+  rxDev->SetChannel (channel);
+  txDev->SetChannel (channel);
+  NetDeviceContainer d;
+  d.Add (txDev);
+  d.Add (rxDev);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer i = ipv4.Assign (d);
+
+  uint16_t port = 5000;
+  PacketSinkHelper sink ("ns3::TcpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), port));
+  ApplicationContainer sinkApps = sink.Install (n.Get (1));
+  sinkApps.Start (Seconds (0.0));
+
+  const uint32_t flows = 100;
+  const uint32_t flowSize = 3000;
+  FlowGeneratorHelper generator ("ns3::TcpSocketFactory", InetSocketAddress (i.GetAddress (1), port));
+  generator.SetAttribute ("InterArrivalTime", StringValue ("ns3::ExponentialRandomVariable[Mean=0.001]"));
+  generator.SetAttribute ("FlowSize", StringValue ("ns3::ConstantRandomVariable[Constant=3000]"));
+  generator.SetAttribute ("MaxConnections", UintegerValue (4));
+  generator.SetAttribute ("MaxFlows", UintegerValue (flows));
+  ApplicationContainer apps = generator.Install (n.Get (0));
+  generator.AssignStreams (n, 0);
+  apps.Start (Seconds (1.0));
+  Ptr<FlowGeneratorApplication> app = DynamicCast<FlowGeneratorApplication> (apps.Get (0));
+  app->TraceConnectWithoutContext ("FlowCompleted", MakeCallback (&FlowGeneratorTestCase::FlowCompleted, this));
+
+  Simulator::Stop (Seconds (10.0));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (app->GetStartedFlows (), flows, "Wrong number of generated flows");
+  NS_TEST_ASSERT_MSG_EQ (app->GetCompletedFlows (), flows, "Not all the flows completed");
+  NS_TEST_ASSERT_MSG_EQ (app->GetWaitingFlows (), 0, "Flows are still waiting");
+  NS_TEST_ASSERT_MSG_LT_OR_EQ (app->GetNConnections (), 4, "Too many connections");
+  NS_TEST_ASSERT_MSG_EQ (m_bytes, static_cast<uint64_t> (flows) * flowSize, "Wrong size of the completed flows");
+  Ptr<PacketSink> sinkApp = DynamicCast<PacketSink> (sinkApps.Get (0));
+  NS_TEST_ASSERT_MSG_EQ (sinkApp->GetTotalRx (), m_bytes, "The sink did not receive all the bytes");
+  NS_TEST_ASSERT_MSG_EQ (sinkApp->GetNConnections (), app->GetNConnections (),
+                         "The sink did not accept all the connections");
+  uint64_t connectionBytes = 0;
+  for (uint32_t j = 0; j < sinkApp->GetNConnections (); j++)
+    {
+      connectionBytes += sinkApp->GetConnectionRx (j);
+    }
+  NS_TEST_ASSERT_MSG_EQ (connectionBytes, m_bytes, "Wrong bytes received on the connections");
+  uint64_t histogramFlows = 0;
+  for (uint32_t j = 0; j < app->GetFctHistogram ().size (); j++)
+    {
+      histogramFlows += app->GetFctHistogram ()[j];
+    }
+  NS_TEST_ASSERT_MSG_EQ (histogramFlows, flows, "Wrong histogram of the flow completion times");
+  NS_TEST_ASSERT_MSG_GT (app->GetMeanFct (), Seconds (0), "Null flow completion time");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Test suite of the FlowGeneratorApplication.
+ */
+class FlowGeneratorTestSuite : public TestSuite
+{
+public:
+  FlowGeneratorTestSuite ();
+};
+
+FlowGeneratorTestSuite::FlowGeneratorTestSuite ()
+  : TestSuite ("flow-generator", UNIT)
+{
+  AddTestCase (new FlowGeneratorTestCase, TestCase::QUICK);
+}
+
+static FlowGeneratorTestSuite flowGeneratorTestSuite;
@@ -254,6 +254,13 @@ void PacketLossCounterTestCase::DoRun (void)
       lossCounter.NotifyReceived (i);
     }
   NS_TEST_ASSERT_MSG_EQ (lossCounter.GetLost (), 9, "Check that 9 (6+1+2) packet are lost");
+
+  // gap larger than the window: drop seqNum 300 to 1299
+  for (uint32_t i = 1300; i < 1400; i++)
+    {
+      lossCounter.NotifyReceived (i);
+    }
+  NS_TEST_ASSERT_MSG_EQ (lossCounter.GetLost (), 1009, "Check that 1009 (9+1000) packets are lost");
 }
 
 /**
@@ -80,6 +80,7 @@ BridgeNetDevice::DoDispose ()
       *iter = 0;
     }
   m_ports.clear ();
+  m_learnState.clear ();
   m_channel = 0;
   m_node = 0;
   NetDevice::DoDispose ();
@@ -150,7 +151,7 @@ BridgeNetDevice::ForwardUnicast (Ptr<NetDevice> incomingPort, Ptr<const Packet>
       for (std::vector< Ptr<NetDevice> >::iterator iter = m_ports.begin ();
            iter != m_ports.end (); iter++)
         {
-          Ptr<NetDevice> port = *iter;
+          const Ptr<NetDevice> &port = *iter;
           if (port != incomingPort)
             {
               NS_LOG_LOGIC ("LearningBridgeForward (" << src << " => " << dst << "): " 
@@ -176,7 +177,7 @@ BridgeNetDevice::ForwardBroadcast (Ptr<NetDevice> incomingPort, Ptr<const Packet
   for (std::vector< Ptr<NetDevice> >::iterator iter = m_ports.begin ();
        iter != m_ports.end (); iter++)
     {
-      Ptr<NetDevice> port = *iter;
+      const Ptr<NetDevice> &port = *iter;
       if (port != incomingPort)
         {
           NS_LOG_LOGIC ("LearningBridgeForward (" << src << " => " << dst << "): " 
@@ -188,12 +189,33 @@ BridgeNetDevice::ForwardBroadcast (Ptr<NetDevice> incomingPort, Ptr<const Packet
     }
 }
 
+uint64_t
+BridgeNetDevice::GetLearnKey (Mac48Address address)
+{
+  uint8_t buffer[6];
+  address.CopyTo (buffer);
+  uint64_t key = 0;
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      key = (key << 8) | buffer[i];
+    }
+  return key;
+}
+
 void BridgeNetDevice::Learn (Mac48Address source, Ptr<NetDevice> port)
 {
   NS_LOG_FUNCTION_NOARGS ();
   if (m_enableLearning)
     {
-      LearnedState &state = m_learnState[source];
+      if (m_expirationTime.IsZero ())
+        {
+          // the state would already be expired: nothing to store, and
+          // nothing left from a previous nonzero expiration time
+          m_learnState.clear ();
+          return;
+        }
+      PurgeLearnedStates ();
+      LearnedState &state = m_learnState[GetLearnKey (source)];
       state.associatedPort = port;
       state.expirationTime = Simulator::Now () + m_expirationTime;
     }
@@ -205,8 +227,8 @@ Ptr<NetDevice> BridgeNetDevice::GetLearnedState (Mac48Address source)
   if (m_enableLearning)
     {
       Time now = Simulator::Now ();
-      std::map<Mac48Address, LearnedState>::iterator iter =
-        m_learnState.find (source);
+      std::unordered_map<uint64_t, LearnedState>::iterator iter =
+        m_learnState.find (GetLearnKey (source));
       if (iter != m_learnState.end ())
         {
           LearnedState &state = iter->second;
@@ -223,6 +245,31 @@ Ptr<NetDevice> BridgeNetDevice::GetLearnedState (Mac48Address source)
   return NULL;
 }
 
+void
+BridgeNetDevice::PurgeLearnedStates (void)
+{
+  Time now = Simulator::Now ();
+  if (now < m_nextPurge)
+    {
+      return;
+    }
+  // the addresses which stopped sending are removed here rather than
+  // when they are looked up, which may never happen
+  m_nextPurge = now + m_expirationTime;
+  for (std::unordered_map<uint64_t, LearnedState>::iterator iter = m_learnState.begin ();
+       iter != m_learnState.end (); )
+    {
+      if (iter->second.expirationTime <= now)
+        {
+          iter = m_learnState.erase (iter);
+        }
+      else
+        {
+          ++iter;
+        }
+    }
+}
+
 uint32_t
 BridgeNetDevice::GetNBridgePorts (void) const
 {
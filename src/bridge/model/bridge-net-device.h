@@ -24,7 +24,9 @@
 #include "ns3/bridge-channel.h"
 #include <stdint.h>
 #include <string>
-#include <map>
+#include <unordered_map>
+
+class BridgeLearningTest;
 
 namespace ns3 {
 
@@ -180,6 +182,19 @@ protected:
    */
   Ptr<NetDevice> GetLearnedState (Mac48Address source);
 
+  /**
+   * \brief Removes the expired learned states, at most once per
+   * expiration time
+   */
+  void PurgeLearnedStates (void);
+
+  /**
+   * \brief Converts a MAC address to the key of the learned states
+   * \param address the address
+   * \returns the 48 bits of the address
+   */
+  static uint64_t GetLearnKey (Mac48Address address);
+
 private:
   /**
    * \brief Copy constructor
@@ -211,13 +226,17 @@ private:
     Ptr<NetDevice> associatedPort; //!< port associated with the address
     Time expirationTime;  //!< time it takes for learned MAC state to expire
   };
-  std::map<Mac48Address, LearnedState> m_learnState; //!< Container for known address statuses
+  /// Container for known address statuses, indexed by GetLearnKey
+  std::unordered_map<uint64_t, LearnedState> m_learnState;
+  Time m_nextPurge; //!< time of the next removal of the expired learned states
   Ptr<Node> m_node; //!< node owning this NetDevice
   Ptr<BridgeChannel> m_channel; //!< virtual bridged channel
   std::vector< Ptr<NetDevice> > m_ports; //!< bridged ports
   uint32_t m_ifIndex; //!< Interface index
   uint16_t m_mtu; //!< MTU of the bridged NetDevice
   bool m_enableLearning; //!< true if the bridge will learn the node status
+
+  friend class ::BridgeLearningTest; // To check the removal of the learned states
 };
 
 } // namespace ns3
@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/bridge-net-device.h"
+
+using namespace ns3;
+
+/**
+ * Check that the BridgeNetDevice learns the port of the source addresses,
+ * that the learned states expire after ExpirationTime and that the expired
+ * states are removed from the table, also when they are never looked up.
+ */
+class BridgeLearningTest : public TestCase
+{
+public:
+  BridgeLearningTest ();
+  virtual ~BridgeLearningTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Learn the port of an address
+   * \param address the source address
+   * \param port the port the address is sending from
+   */
+  void Learn (Mac48Address address, Ptr<NetDevice> port);
+  /**
+   * Check the port learned for an address
+   * \param address the address
+   * \param port the expected port, or 0 if the state should have expired
+   */
+  void CheckPort (Mac48Address address, Ptr<NetDevice> port);
+  /**
+   * Check the number of learned states held by the bridge
+   * \param size the expected number of states
+   */
+  void CheckSize (uint32_t size);
+
+  Ptr<BridgeNetDevice> m_bridge; ///< the bridge under test
+};
+
+BridgeLearningTest::BridgeLearningTest ()
+  : TestCase ("Learning and expiration of the bridged addresses")
+{
+}
+
+BridgeLearningTest::~BridgeLearningTest ()
+{
+}
+
+void
+BridgeLearningTest::Learn (Mac48Address address, Ptr<NetDevice> port)
+{
+  m_bridge->Learn (address, port);
+}
+
+void
+BridgeLearningTest::CheckPort (Mac48Address address, Ptr<NetDevice> port)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_bridge->GetLearnedState (address), port,
+                         "Wrong port learned for " << address << " at " << Simulator::Now ().GetSeconds () << " s");
+}
+
+void
+BridgeLearningTest::CheckSize (uint32_t size)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_bridge->m_learnState.size (), size,
+                         "Wrong number of learned states at " << Simulator::Now ().GetSeconds () << " s");
+}
+
+void
+BridgeLearningTest::DoRun (void)
+{
+  Ptr<NetDevice> port1 = CreateObject<SimpleNetDevice> ();
+  Ptr<NetDevice> port2 = CreateObject<SimpleNetDevice> ();
+  Mac48Address a ("00:00:00:00:00:01");
+  Mac48Address b ("00:00:00:00:00:02");
+  Mac48Address c ("00:00:00:00:00:03");
+  Ptr<NetDevice> none = 0;
+
+  m_bridge = CreateObject<BridgeNetDevice> ();
+  m_bridge->SetAttribute ("ExpirationTime", TimeValue (Seconds (10)));
+
+  // a and b are learned at 0 s, a is refreshed at 5 s
+  Simulator::Schedule (Seconds (0), &BridgeLearningTest::Learn, this, a, port1);
+  Simulator::Schedule (Seconds (0), &BridgeLearningTest::Learn, this, b, port2);
+  Simulator::Schedule (Seconds (1), &BridgeLearningTest::CheckPort, this, a, port1);
+  Simulator::Schedule (Seconds (1), &BridgeLearningTest::CheckPort, this, b, port2);
+  Simulator::Schedule (Seconds (1), &BridgeLearningTest::CheckSize, this, 2);
+  Simulator::Schedule (Seconds (5), &BridgeLearningTest::Learn, this, a, port2);
+  // b has expired and is removed when c is learned, a is still valid
+  Simulator::Schedule (Seconds (12), &BridgeLearningTest::Learn, this, c, port1);
+  Simulator::Schedule (Seconds (12), &BridgeLearningTest::CheckSize, this, 2);
+  Simulator::Schedule (Seconds (13), &BridgeLearningTest::CheckPort, this, a, port2);
+  Simulator::Schedule (Seconds (13), &BridgeLearningTest::CheckPort, this, c, port1);
+  // a has expired and is removed when it is looked up
+  Simulator::Schedule (Seconds (16), &BridgeLearningTest::CheckPort, this, a, none);
+  Simulator::Schedule (Seconds (16), &BridgeLearningTest::CheckSize, this, 1);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // with a zero expiration time nothing is ever forwarded to a learned
+  // port, and the sources which are never looked up are not stored
+  m_bridge = CreateObject<BridgeNetDevice> ();
+  m_bridge->SetAttribute ("ExpirationTime", TimeValue (Seconds (0)));
+  Simulator::Schedule (Seconds (1), &BridgeLearningTest::Learn, this, a, port1);
+  Simulator::Schedule (Seconds (1), &BridgeLearningTest::Learn, this, b, port2);
+  Simulator::Schedule (Seconds (1), &BridgeLearningTest::CheckSize, this, 0);
+  Simulator::Schedule (Seconds (2), &BridgeLearningTest::Learn, this, c, port1);
+  Simulator::Schedule (Seconds (2), &BridgeLearningTest::CheckSize, this, 0);
+  Simulator::Schedule (Seconds (2), &BridgeLearningTest::CheckPort, this, a, none);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  m_bridge = 0;
+}
+
+/**
+ * \ingroup bridge
+ * The bridge test suite
+ */
+class BridgeTestSuite : public TestSuite
+{
+public:
+  BridgeTestSuite ();
+};
+
+BridgeTestSuite::BridgeTestSuite ()
+  : TestSuite ("bridge", UNIT)
+{
+  AddTestCase (new BridgeLearningTest, TestCase::QUICK);
+}
+
+static BridgeTestSuite g_bridgeTestSuite; ///< the test suite
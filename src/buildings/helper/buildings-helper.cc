@@ -79,25 +79,19 @@ void
 BuildingsHelper::MakeConsistent (Ptr<MobilityModel> mm)
 {
   Ptr<MobilityBuildingInfo> bmm = mm->GetObject<MobilityBuildingInfo> ();
-  bool found = false;
-  for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+  Vector pos = mm->GetPosition ();
+  Ptr<Building> building = BuildingList::FindBuilding (pos);
+  if (building != 0)
     {
-      NS_LOG_LOGIC ("checking building " << (*bit)->GetId () << " with boundaries " << (*bit)->GetBoundaries ());
-      Vector pos = mm->GetPosition ();
-      if ((*bit)->IsInside (pos))
-        {
-          NS_LOG_LOGIC ("MobilityBuildingInfo " << bmm << " pos " << mm->GetPosition () << " falls inside building " << (*bit)->GetId ());
-          NS_ABORT_MSG_UNLESS (found == false, " MobilityBuildingInfo already inside another building!");		
-          found = true;
-          uint16_t floor = (*bit)->GetFloor (pos);
-          uint16_t roomX = (*bit)->GetRoomX (pos);
-          uint16_t roomY = (*bit)->GetRoomY (pos);	   
-          bmm->SetIndoor (*bit, floor, roomX, roomY);	      
-        }		    	  
+      NS_LOG_LOGIC ("MobilityBuildingInfo " << bmm << " pos " << pos << " falls inside building " << building->GetId ());
+      uint16_t floor = building->GetFloor (pos);
+      uint16_t roomX = building->GetRoomX (pos);
+      uint16_t roomY = building->GetRoomY (pos);
+      bmm->SetIndoor (building, floor, roomX, roomY);
     }
-  if (!found)
+  else
     {
-      NS_LOG_LOGIC ("MobilityBuildingInfo " << bmm << " pos " << mm->GetPosition ()  << " is outdoor");
+      NS_LOG_LOGIC ("MobilityBuildingInfo " << bmm << " pos " << pos << " is outdoor");
       bmm->SetOutdoor ();
     }
 
@@ -25,8 +25,11 @@
 #include "ns3/config.h"
 #include "ns3/log.h"
 #include "ns3/assert.h"
+#include "ns3/abort.h"
 #include "building-list.h"
 #include "building.h"
+#include <algorithm>
+#include <cmath>
 
 namespace ns3 {
 
@@ -47,6 +50,8 @@ public:
   BuildingList::Iterator End (void) const;
   Ptr<Building> GetBuilding (uint32_t n);
   uint32_t GetNBuildings (void);
+  Ptr<Building> FindBuilding (const Vector &position);
+  void InvalidateIndex (void);
 
   static Ptr<BuildingListPriv> Get (void);
 
@@ -54,7 +59,29 @@ private:
   virtual void DoDispose (void);
   static Ptr<BuildingListPriv> *DoGet (void);
   static void Delete (void);
+  /**
+   * Build the grid of the buildings.
+   */
+  void BuildIndex (void);
+  /**
+   * \param x a coordinate
+   * \param min the smallest coordinate of the grid
+   * \param n the number of cells along the coordinate
+   * \returns the index of the cell along the coordinate
+   */
+  uint32_t GetCell (double x, double min, uint32_t n) const;
+
   std::vector<Ptr<Building> > m_buildings;
+  bool m_indexValid;   //!< whether the grid matches the buildings
+  double m_xMin;       //!< smallest x of the grid
+  double m_yMin;       //!< smallest y of the grid
+  double m_xMax;       //!< largest x of the grid
+  double m_yMax;       //!< largest y of the grid
+  double m_cellSize;   //!< side of the cells of the grid
+  uint32_t m_nX;       //!< number of cells along x
+  uint32_t m_nY;       //!< number of cells along y
+  /// indices of the buildings overlapping each cell, row after row
+  std::vector<std::vector<uint32_t> > m_cells;
 };
 
 NS_OBJECT_ENSURE_REGISTERED (BuildingListPriv);
@@ -100,6 +127,14 @@ BuildingListPriv::Delete (void)
 
 
 BuildingListPriv::BuildingListPriv ()
+  : m_indexValid (false),
+    m_xMin (0),
+    m_yMin (0),
+    m_xMax (0),
+    m_yMax (0),
+    m_cellSize (1),
+    m_nX (0),
+    m_nY (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -118,6 +153,8 @@ BuildingListPriv::DoDispose (void)
       *i = 0;
     }
   m_buildings.erase (m_buildings.begin (), m_buildings.end ());
+  m_cells.clear ();
+  m_indexValid = false;
   Object::DoDispose ();
 }
 
@@ -127,6 +164,7 @@ BuildingListPriv::Add (Ptr<Building> building)
 {
   uint32_t index = m_buildings.size ();
   m_buildings.push_back (building);
+  m_indexValid = false;
   Simulator::ScheduleWithContext (index, TimeStep (0), &Building::Initialize, building);
   return index;
 
@@ -155,6 +193,114 @@ BuildingListPriv::GetBuilding (uint32_t n)
   return m_buildings.at (n);
 }
 
+void
+BuildingListPriv::InvalidateIndex (void)
+{
+  m_indexValid = false;
+}
+
+uint32_t
+BuildingListPriv::GetCell (double x, double min, uint32_t n) const
+{
+  double cell = std::floor ((x - min) / m_cellSize);
+  if (cell <= 0)
+    {
+      return 0;
+    }
+  return std::min (static_cast<uint32_t> (cell), n - 1);
+}
+
+void
+BuildingListPriv::BuildIndex (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_cells.clear ();
+  m_indexValid = true;
+  m_nX = 0;
+  m_nY = 0;
+  if (m_buildings.empty ())
+    {
+      return;
+    }
+
+  // the grid covers all the buildings, with cells of about the mean
+  // size of a building
+  Box first = m_buildings.front ()->GetBoundaries ();
+  m_xMin = first.xMin;
+  m_xMax = first.xMax;
+  m_yMin = first.yMin;
+  m_yMax = first.yMax;
+  double totalSize = 0;
+  for (std::vector<Ptr<Building> >::const_iterator i = m_buildings.begin (); i != m_buildings.end (); ++i)
+    {
+      Box box = (*i)->GetBoundaries ();
+      m_xMin = std::min (m_xMin, box.xMin);
+      m_xMax = std::max (m_xMax, box.xMax);
+      m_yMin = std::min (m_yMin, box.yMin);
+      m_yMax = std::max (m_yMax, box.yMax);
+      totalSize += std::max (box.xMax - box.xMin, box.yMax - box.yMin);
+    }
+  m_cellSize = totalSize / m_buildings.size ();
+  if (!(m_cellSize > 0))
+    {
+      m_cellSize = 1;
+    }
+  // bound the number of cells to a few per building
+  double maxCells = 4.0 * m_buildings.size () + 64;
+  while ((std::floor ((m_xMax - m_xMin) / m_cellSize) + 1) * (std::floor ((m_yMax - m_yMin) / m_cellSize) + 1) > maxCells)
+    {
+      m_cellSize *= 2;
+    }
+  m_nX = static_cast<uint32_t> (std::floor ((m_xMax - m_xMin) / m_cellSize)) + 1;
+  m_nY = static_cast<uint32_t> (std::floor ((m_yMax - m_yMin) / m_cellSize)) + 1;
+  m_cells.resize (m_nX * m_nY);
+  for (uint32_t i = 0; i < m_buildings.size (); i++)
+    {
+      Box box = m_buildings[i]->GetBoundaries ();
+      uint32_t xFirst = GetCell (box.xMin, m_xMin, m_nX);
+      uint32_t xLast = GetCell (box.xMax, m_xMin, m_nX);
+      uint32_t yFirst = GetCell (box.yMin, m_yMin, m_nY);
+      uint32_t yLast = GetCell (box.yMax, m_yMin, m_nY);
+      for (uint32_t y = yFirst; y <= yLast; y++)
+        {
+          for (uint32_t x = xFirst; x <= xLast; x++)
+            {
+              m_cells[y * m_nX + x].push_back (i);
+            }
+        }
+    }
+  NS_LOG_DEBUG ("Indexed " << m_buildings.size () << " buildings in " << m_nX << "x" << m_nY
+                           << " cells of " << m_cellSize << " m");
+}
+
+Ptr<Building>
+BuildingListPriv::FindBuilding (const Vector &position)
+{
+  if (!m_indexValid)
+    {
+      BuildIndex ();
+    }
+  if (m_cells.empty ()
+      || position.x < m_xMin || position.x > m_xMax
+      || position.y < m_yMin || position.y > m_yMax)
+    {
+      return 0;
+    }
+  const std::vector<uint32_t> &cell = m_cells[GetCell (position.y, m_yMin, m_nY) * m_nX
+                                              + GetCell (position.x, m_xMin, m_nX)];
+  Ptr<Building> found = 0;
+  for (std::vector<uint32_t>::const_iterator i = cell.begin (); i != cell.end (); ++i)
+    {
+      if (m_buildings[*i]->IsInside (position))
+        {
+          NS_ABORT_MSG_UNLESS (found == 0, "position " << position << " is inside buildings "
+                               << found->GetId () << " and " << m_buildings[*i]->GetId ());
+          found = m_buildings[*i];
+        }
+    }
+  return found;
+}
+
 }
 
 /**
@@ -189,5 +335,15 @@ BuildingList::GetNBuildings (void)
 {
   return BuildingListPriv::Get ()->GetNBuildings ();
 }
+Ptr<Building>
+BuildingList::FindBuilding (const Vector &position)
+{
+  return BuildingListPriv::Get ()->FindBuilding (position);
+}
+void
+BuildingList::NotifyBoundariesChanged (void)
+{
+  BuildingListPriv::Get ()->InvalidateIndex ();
+}
 
 } // namespace ns3
@@ -25,6 +25,7 @@
 
 #include <vector>
 #include "ns3/ptr.h"
+#include "ns3/vector.h"
 
 namespace ns3 {
 
@@ -62,6 +63,26 @@ public:
    * \returns the number of buildings currently in the list.
    */
   static uint32_t GetNBuildings (void);
+  /**
+   * Find the building which contains a position.
+   *
+   * The buildings are looked up in a uniform grid over their xy
+   * boundaries, which is built when first needed and rebuilt after a
+   * building is added or its boundaries change, so that the cost of a
+   * lookup does not grow with the number of buildings. The simulation
+   * is aborted if the position is inside several buildings.
+   *
+   * \param position the position
+   * \returns the building which contains the position, or 0 if the
+   * position is outdoor
+   */
+  static Ptr<Building> FindBuilding (const Vector &position);
+  /**
+   * Notify the list that the boundaries of a building changed.
+   *
+   * This method is called automatically from Building::SetBoundaries.
+   */
+  static void NotifyBoundariesChanged (void);
 };
 
 } // namespace ns3
@@ -25,6 +25,7 @@
 #include <ns3/mobility-building-info.h>
 #include <ns3/constant-position-mobility-model.h>
 #include <ns3/building.h>
+#include <ns3/building-list.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/mobility-helper.h>
 #include <ns3/simulator.h>
@@ -167,10 +168,98 @@ BuildingsHelperOneTestCase::DoRun ()
   Simulator::Destroy ();  
 }
 
+/**
+ * Check that the buildings found by BuildingList::FindBuilding are the
+ * ones found by scanning the whole list, including after a building moved.
+ */
+class BuildingListFindTestCase : public TestCase
+{
+public:
+  BuildingListFindTestCase ();
 
+private:
+  virtual void DoRun (void);
+  /**
+   * \param position a position
+   * \returns the building which contains the position, found by a linear scan
+   */
+  static Ptr<Building> Scan (Vector position);
+  /**
+   * Compare FindBuilding and Scan over a set of positions.
+   */
+  void Check (void);
+};
 
+BuildingListFindTestCase::BuildingListFindTestCase ()
+  : TestCase ("BuildingList::FindBuilding on a city grid")
+{
+}
 
+Ptr<Building>
+BuildingListFindTestCase::Scan (Vector position)
+{
+  for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+    {
+      if ((*bit)->IsInside (position))
+        {
+          return *bit;
+        }
+    }
+  return 0;
+}
 
+void
+BuildingListFindTestCase::Check (void)
+{
+  for (double x = -15.5; x < 420; x += 5.25)
+    {
+      for (double y = -15.5; y < 420; y += 6.75)
+        {
+          for (double z = 1; z < 40; z += 18)
+            {
+              Vector position (x, y, z);
+              NS_TEST_ASSERT_MSG_EQ (BuildingList::FindBuilding (position), Scan (position),
+                                     "Wrong building at " << position);
+            }
+        }
+    }
+  // positions on the walls
+  for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+    {
+      Box box = (*bit)->GetBoundaries ();
+      NS_TEST_ASSERT_MSG_EQ (BuildingList::FindBuilding (Vector (box.xMin, box.yMin, box.zMin)), *bit,
+                             "Wrong building at the corner of building " << (*bit)->GetId ());
+      NS_TEST_ASSERT_MSG_EQ (BuildingList::FindBuilding (Vector (box.xMax, box.yMax, box.zMax)), *bit,
+                             "Wrong building at the corner of building " << (*bit)->GetId ());
+    }
+}
+
+void
+BuildingListFindTestCase::DoRun (void)
+{
+  // blocks of different sizes, separated by streets
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      for (uint32_t j = 0; j < 20; j++)
+        {
+          Ptr<Building> b = CreateObject<Building> ();
+          double width = 5 + (i * 7 + j * 3) % 11;
+          b->SetBoundaries (Box (i * 20.0, i * 20.0 + width, j * 20.0, j * 20.0 + 15, 0, 10 + (i + j) % 3 * 10));
+        }
+    }
+  Check ();
+
+  // a large building which moves over a street
+  Ptr<Building> large = CreateObject<Building> ();
+  large->SetBoundaries (Box (400, 500, -10, -2, 0, 30));
+  Check ();
+  large->SetBoundaries (Box (-10, -2, 100, 300, 0, 30));
+  Check ();
+  NS_TEST_ASSERT_MSG_EQ (BuildingList::FindBuilding (Vector (-5, 200, 10)), large, "The large building moved");
+  NS_TEST_ASSERT_MSG_EQ (BuildingList::FindBuilding (Vector (450, -5, 10)), 0, "The large building moved");
+
+  Simulator::Destroy ();
+}
 
 
 class BuildingsHelperTestSuite : public TestSuite
@@ -258,6 +347,8 @@ BuildingsHelperTestSuite::BuildingsHelperTestSuite ()
   p9.indoor = false;
   AddTestCase (new BuildingsHelperOneTestCase (p9, b1), TestCase::QUICK);
 
+  AddTestCase (new BuildingListFindTestCase, TestCase::QUICK);
+
 
 
 
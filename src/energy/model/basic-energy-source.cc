@@ -61,7 +61,9 @@ BasicEnergySource::GetTypeId (void)
                    MakeDoubleAccessor (&BasicEnergySource::m_highBatteryTh),
                    MakeDoubleChecker<double> ())
     .AddAttribute ("PeriodicEnergyUpdateInterval",
-                   "Time between two consecutive periodic energy updates.",
+                   "Time between two consecutive periodic energy updates. "
+                   "If zero, the energy is only updated when it is queried, "
+                   "when the current drawn changes, and when a battery threshold is crossed.",
                    TimeValue (Seconds (1.0)),
                    MakeTimeAccessor (&BasicEnergySource::SetEnergyUpdateInterval,
                                      &BasicEnergySource::GetEnergyUpdateInterval),
@@ -79,6 +81,7 @@ BasicEnergySource::BasicEnergySource ()
   NS_LOG_FUNCTION (this);
   m_lastUpdateTime = Seconds (0.0);
   m_depleted = false;
+  m_totalCurrentA = 0.0;
 }
 
 BasicEnergySource::~BasicEnergySource ()
@@ -135,7 +138,7 @@ BasicEnergySource::GetRemainingEnergy (void)
 {
   NS_LOG_FUNCTION (this);
   // update energy source to get the latest remaining energy.
-  UpdateEnergySource ();
+  UpdateOnQuery ();
   return m_remainingEnergyJ;
 }
 
@@ -144,7 +147,7 @@ BasicEnergySource::GetEnergyFraction (void)
 {
   NS_LOG_FUNCTION (this);
   // update energy source to get the latest remaining energy.
-  UpdateEnergySource ();
+  UpdateOnQuery ();
   return m_remainingEnergyJ / m_initialEnergyJ;
 }
 
@@ -160,27 +163,25 @@ BasicEnergySource::UpdateEnergySource (void)
       return;
     }
 
-  m_energyUpdateEvent.Cancel ();
-
-  CalculateRemainingEnergy ();
-
-  m_lastUpdateTime = Simulator::Now ();
-
-  if (!m_depleted && m_remainingEnergyJ <= m_lowBatteryTh * m_initialEnergyJ)
+  if (m_energyUpdateInterval.IsZero ())
     {
-      m_depleted = true;
-      HandleEnergyDrainedEvent ();
+      IntegrateRemainingEnergy ();
+      // the device models update the source before changing their
+      // current, so the threshold is checked once they have changed it
+      if (!m_currentCheckEvent.IsRunning ())
+        {
+          m_currentCheckEvent = Simulator::ScheduleNow (&BasicEnergySource::ScheduleThresholdUpdate,
+                                                        this);
+        }
     }
-
-  if (m_depleted && m_remainingEnergyJ > m_highBatteryTh * m_initialEnergyJ)
+  else
     {
-      m_depleted = false;
-      HandleEnergyRechargedEvent ();
+      m_energyUpdateEvent.Cancel ();
+      IntegrateRemainingEnergy ();
+      m_energyUpdateEvent = Simulator::Schedule (m_energyUpdateInterval,
+                                                 &BasicEnergySource::UpdateEnergySource,
+                                                 this);
     }
-
-  m_energyUpdateEvent = Simulator::Schedule (m_energyUpdateInterval,
-                                             &BasicEnergySource::UpdateEnergySource,
-                                             this);
 }
 
 /*
@@ -217,6 +218,43 @@ BasicEnergySource::HandleEnergyRechargedEvent (void)
   NotifyEnergyRecharged (); // notify DeviceEnergyModel objects
 }
 
+void
+BasicEnergySource::UpdateOnQuery (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_energyUpdateInterval.IsZero ())
+    {
+      UpdateEnergySource ();
+    }
+  else if (!Simulator::IsFinished ())
+    {
+      // a query does not change the current, so the pending
+      // threshold update is kept
+      IntegrateRemainingEnergy ();
+    }
+}
+
+void
+BasicEnergySource::IntegrateRemainingEnergy (void)
+{
+  NS_LOG_FUNCTION (this);
+  CalculateRemainingEnergy ();
+
+  m_lastUpdateTime = Simulator::Now ();
+
+  if (!m_depleted && m_remainingEnergyJ <= m_lowBatteryTh * m_initialEnergyJ)
+    {
+      m_depleted = true;
+      HandleEnergyDrainedEvent ();
+    }
+
+  if (m_depleted && m_remainingEnergyJ > m_highBatteryTh * m_initialEnergyJ)
+    {
+      m_depleted = false;
+      HandleEnergyRechargedEvent ();
+    }
+}
+
 void
 BasicEnergySource::CalculateRemainingEnergy (void)
 {
@@ -239,4 +277,41 @@ BasicEnergySource::CalculateRemainingEnergy (void)
   NS_LOG_DEBUG ("BasicEnergySource:Remaining energy = " << m_remainingEnergyJ);
 }
 
+void
+BasicEnergySource::ScheduleThresholdUpdate (void)
+{
+  NS_LOG_FUNCTION (this);
+  double totalCurrentA = CalculateTotalCurrent ();
+  if (totalCurrentA == m_totalCurrentA && m_energyUpdateEvent.IsRunning ())
+    {
+      // the pending update is still on time
+      return;
+    }
+  m_energyUpdateEvent.Cancel ();
+  m_totalCurrentA = totalCurrentA;
+  double powerW = m_totalCurrentA * m_supplyVoltageV;
+  double energyToThresholdJ;
+  if (!m_depleted && powerW > 0)
+    {
+      energyToThresholdJ = m_remainingEnergyJ - m_lowBatteryTh * m_initialEnergyJ;
+    }
+  else if (m_depleted && powerW < 0)
+    {
+      energyToThresholdJ = m_remainingEnergyJ - m_highBatteryTh * m_initialEnergyJ;
+    }
+  else
+    {
+      return;
+    }
+  double delayS = energyToThresholdJ / powerW;
+  if (delayS >= (Simulator::GetMaximumSimulationTime () - Simulator::Now ()).GetSeconds ())
+    {
+      return;
+    }
+  // one more time step so that the threshold is crossed at the update
+  Time delay = Seconds (delayS) + TimeStep (1);
+  NS_LOG_DEBUG ("BasicEnergySource:Threshold crossed in " << delay.GetSeconds () << " s");
+  m_energyUpdateEvent = Simulator::Schedule (delay, &BasicEnergySource::UpdateEnergySource, this);
+}
+
 } // namespace ns3
@@ -33,6 +33,14 @@ namespace ns3 {
  * BasicEnergySource decreases/increases remaining energy stored in itself in
  * linearly.
  *
+ * By default, the remaining energy is updated periodically. When the
+ * PeriodicEnergyUpdateInterval attribute is zero, there is no periodic
+ * update: since the current drawn from the source does not change between
+ * two updates (device state changes and harvester updates update the
+ * source), the remaining energy is integrated only when it is queried or
+ * the current changes, and a single update is scheduled when the low
+ * (resp. high) battery threshold would be crossed.
+ *
  */
 class BasicEnergySource : public EnergySource
 {
@@ -93,7 +101,8 @@ public:
   /**
    * \param interval Energy update interval.
    *
-   * This function sets the interval between each energy update.
+   * This function sets the interval between each energy update. No periodic
+   * update is done if the interval is zero.
    */
   void SetEnergyUpdateInterval (Time interval);
 
@@ -125,6 +134,19 @@ private:
    */
   void HandleEnergyRechargedEvent (void);
 
+  /**
+   * Updates the remaining energy before it is queried. Without periodic
+   * updates, the pending threshold update is kept, since a query does not
+   * change the current.
+   */
+  void UpdateOnQuery (void);
+
+  /**
+   * Calculates the remaining energy, and notifies the energy models when
+   * it crosses the low (resp. high) battery threshold.
+   */
+  void IntegrateRemainingEnergy (void);
+
   /**
    * Calculates remaining energy. This function uses the total current from all
    * device models to calculate the amount of energy to decrease. The energy to
@@ -135,6 +157,16 @@ private:
    */
   void CalculateRemainingEnergy (void);
 
+  /**
+   * Schedules the next energy update at the time the remaining energy
+   * crosses the low (resp. high) battery threshold, if the total current
+   * does not change until then. Called in an event of its own after each
+   * update, so that it uses the current set by the device model which
+   * triggered the update; the pending update is kept if that current is
+   * the one it was computed from.
+   */
+  void ScheduleThresholdUpdate (void);
+
 private:
   double m_initialEnergyJ;                // initial energy, in Joules
   double m_supplyVoltageV;                // supply voltage, in Volts
@@ -144,8 +176,10 @@ private:
                                           // set to false again when the remaining energy exceeds the high threshold
   TracedValue<double> m_remainingEnergyJ; // remaining energy, in Joules
   EventId m_energyUpdateEvent;            // energy update event
+  EventId m_currentCheckEvent;            // check of the current after an update, without periodic updates
   Time m_lastUpdateTime;                  // last update time
   Time m_energyUpdateInterval;            // energy update interval
+  double m_totalCurrentA;                 // total current the threshold update was computed from, in Amperes
 
 };
 
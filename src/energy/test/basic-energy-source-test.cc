@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simple-device-energy-model.h"
+#include "ns3/basic-energy-source.h"
+#include "ns3/node.h"
+#include "ns3/double.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("BasicEnergySourceTestSuite");
+
+/**
+ * Check that a BasicEnergySource without periodic updates integrates the
+ * energy when it is queried and is updated when the low battery
+ * threshold is crossed, also when the device current changes during the
+ * simulation.
+ */
+class BasicEnergySourceLazyTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param switchTime time at which the device starts drawing current
+   */
+  BasicEnergySourceLazyTestCase (Time switchTime);
+  ~BasicEnergySourceLazyTestCase ();
+
+  void DoRun (void);
+
+private:
+  /**
+   * Trace sink of the remaining energy.
+   * \param oldValue the previous remaining energy
+   * \param newValue the remaining energy
+   */
+  void RemainingEnergy (double oldValue, double newValue);
+  /**
+   * Check the remaining energy of the source.
+   * \param source the energy source
+   * \param expected the expected remaining energy
+   */
+  void CheckRemainingEnergy (Ptr<BasicEnergySource> source, double expected);
+
+  Time m_switchTime;    // time at which the device starts drawing current
+  uint32_t m_nUpdates;  // number of changes of the remaining energy
+  Time m_lastUpdate;    // time of the last change of the remaining energy
+};
+
+BasicEnergySourceLazyTestCase::BasicEnergySourceLazyTestCase (Time switchTime)
+  : TestCase (std::string ("Basic energy source without periodic updates")
+              + (switchTime.IsZero () ? "" : ", current switched on during the run")),
+    m_switchTime (switchTime),
+    m_nUpdates (0)
+{
+}
+
+BasicEnergySourceLazyTestCase::~BasicEnergySourceLazyTestCase ()
+{
+}
+
+void
+BasicEnergySourceLazyTestCase::RemainingEnergy (double oldValue, double newValue)
+{
+  m_nUpdates++;
+  m_lastUpdate = Simulator::Now ();
+}
+
+void
+BasicEnergySourceLazyTestCase::CheckRemainingEnergy (Ptr<BasicEnergySource> source, double expected)
+{
+  NS_TEST_ASSERT_MSG_EQ_TOL (source->GetRemainingEnergy (), expected, 1.0e-9,
+                             "Incorrect remaining energy at " << Simulator::Now ().GetSeconds () << " s");
+}
+
+void
+BasicEnergySourceLazyTestCase::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+
+  Ptr<SimpleDeviceEnergyModel> sem = CreateObject<SimpleDeviceEnergyModel> ();
+  Ptr<BasicEnergySource> es = CreateObject<BasicEnergySource> ();
+  es->SetAttribute ("BasicEnergySourceInitialEnergyJ", DoubleValue (10));
+  es->SetAttribute ("BasicEnergySupplyVoltageV", DoubleValue (3));
+  es->SetAttribute ("BasicEnergyLowBatteryThreshold", DoubleValue (0.1));
+  es->SetEnergyUpdateInterval (Seconds (0));
+  es->TraceConnectWithoutContext ("RemainingEnergy",
+                                  MakeCallback (&BasicEnergySourceLazyTestCase::RemainingEnergy, this));
+
+  es->SetNode (node);
+  sem->SetEnergySource (es);
+  es->AppendDeviceEnergyModel (sem);
+  node->AggregateObject (es);
+
+  // 0.03 W: the low battery threshold (1 J) is crossed after 300 seconds
+  uint32_t expectedUpdates;
+  if (m_switchTime.IsZero ())
+    {
+      sem->SetCurrentA (0.01);
+      Simulator::Schedule (Seconds (200), &BasicEnergySourceLazyTestCase::CheckRemainingEnergy, this, es, 4.0);
+      expectedUpdates = 2;
+    }
+  else
+    {
+      // the threshold update is scheduled from the update made by the
+      // device model, and kept by the queries which follow
+      Simulator::Schedule (m_switchTime / 2, &BasicEnergySourceLazyTestCase::CheckRemainingEnergy, this, es, 10.0);
+      Simulator::Schedule (m_switchTime, &SimpleDeviceEnergyModel::SetCurrentA, sem, 0.01);
+      Simulator::Schedule (m_switchTime + Seconds (100),
+                           &BasicEnergySourceLazyTestCase::CheckRemainingEnergy, this, es, 7.0);
+      expectedUpdates = 2;
+    }
+
+  Simulator::Stop (m_switchTime + Seconds (320));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_nUpdates, expectedUpdates, "Wrong number of updates of the remaining energy");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_lastUpdate.GetSeconds (), (m_switchTime + Seconds (300)).GetSeconds (), 1.0e-6,
+                             "The low battery threshold update is not on time");
+
+  Simulator::Destroy ();
+}
+
+class BasicEnergySourceTestSuite : public TestSuite
+{
+public:
+  BasicEnergySourceTestSuite ();
+};
+
+BasicEnergySourceTestSuite::BasicEnergySourceTestSuite ()
+  : TestSuite ("basic-energy-source", UNIT)
+{
+  AddTestCase (new BasicEnergySourceLazyTestCase (Seconds (0)), TestCase::QUICK);
+  AddTestCase (new BasicEnergySourceLazyTestCase (Seconds (10)), TestCase::QUICK);
+}
+
+// create an instance of the test suite
+static BasicEnergySourceTestSuite g_basicEnergySourceTestSuite;
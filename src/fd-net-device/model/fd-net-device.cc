@@ -174,6 +174,7 @@ FdNetDevice::FdNetDevice ()
     m_fdReader (0),
     m_isBroadcast (true),
     m_isMulticast (false),
+    m_forwardUpScheduled (false),
     m_startEvent (),
     m_stopEvent ()
 {
@@ -290,6 +291,7 @@ FdNetDevice::ReceiveCallback (uint8_t *buf, ssize_t len)
 {
   NS_LOG_FUNCTION (this << buf << len);
   bool skip = false;
+  bool schedule = false;
 
   {
     CriticalSection cs (m_pendingReadMutex);
@@ -301,6 +303,9 @@ FdNetDevice::ReceiveCallback (uint8_t *buf, ssize_t len)
     else
       {
         m_pendingQueue.push (std::make_pair (buf, len));
+        // a single event forwards all the frames received until it runs
+        schedule = !m_forwardUpScheduled;
+        m_forwardUpScheduled = true;
       }
   }
 
@@ -311,7 +316,7 @@ FdNetDevice::ReceiveCallback (uint8_t *buf, ssize_t len)
       };                                        // 100 ms
       nanosleep (&time, NULL);
     }
-  else
+  else if (schedule)
     {
       Simulator::ScheduleWithContext (m_nodeId, Time (0), MakeEvent (&FdNetDevice::ForwardUp, this));
     }
@@ -320,19 +325,15 @@ FdNetDevice::ReceiveCallback (uint8_t *buf, ssize_t len)
 /**
  * \ingroup fd-net-device
  * \brief Synthesize PI header for the kernel
- * \param buf the buffer to add the header to
- * \param len the buffer length
- *
- * \todo Consider having a instance member m_packetBuffer and using memmove
- * instead of memcpy to add the PI header. It might be faster in this case
- * to use memmove and avoid the extra mallocs.
+ * \param buf the buffer to write the header to, followed by the frame
+ * \param len the frame length
  */
 static void
-AddPIHeader (uint8_t *&buf, size_t &len)
+AddPIHeader (uint8_t *buf, size_t len)
 {
-  // Synthesize PI header for our friend the kernel
-  uint8_t *buf2 = (uint8_t*)malloc (len + 4);
-  memcpy (buf2 + 4, buf, len);
+  // Synthesize PI header for our friend the kernel, in the four bytes
+  // reserved in front of the frame
+  const uint8_t *frame = buf + 4;
   len += 4;
 
   // PI = 16 bits flags (0) + 16 bits proto
@@ -342,73 +343,64 @@ AddPIHeader (uint8_t *&buf, size_t &len)
   uint16_t proto = 0x0008; // default to IPv4
   if (len > 14)
     {
-      if (buf[12] == 0x81 && buf[13] == 0x00 && len > 18)
+      if (frame[12] == 0x81 && frame[13] == 0x00 && len > 18)
         {
           // tagged ethernet packet
-          proto = buf[16] | (buf[17] << 8);
+          proto = frame[16] | (frame[17] << 8);
         }
       else
         {
           // untagged ethernet packet
-          proto = buf[12] | (buf[13] << 8);
+          proto = frame[12] | (frame[13] << 8);
         }
     }
-  buf2[0] = (uint8_t)flags;
-  buf2[1] = (uint8_t)(flags >> 8);
-  buf2[2] = (uint8_t)proto;
-  buf2[3] = (uint8_t)(proto >> 8);
-
-  // swap buffer
-  free (buf);
-  buf = buf2;
-}
-
-/**
- * \ingroup fd-net-device
- * \brief Removes PI header
- * \param buf the buffer to add the header to
- * \param len the buffer length
- */
-static void
-RemovePIHeader (uint8_t *&buf, ssize_t &len)
-{
-  // strip PI header if present, shrink buffer
-  if (len >= 4)
-    {
-      len -= 4;
-      memmove (buf, buf + 4, len);
-      buf = (uint8_t*)realloc (buf, len);
-    }
+  buf[0] = (uint8_t)flags;
+  buf[1] = (uint8_t)(flags >> 8);
+  buf[2] = (uint8_t)proto;
+  buf[3] = (uint8_t)(proto >> 8);
 }
 
 void
 FdNetDevice::ForwardUp (void)
 {
+  NS_LOG_FUNCTION (this);
 
-  uint8_t *buf = 0; 
-  ssize_t len = 0;
-
+  //
+  // Take all the frames received so far at once, so that the reader thread
+  // is not held on the mutex for each of them.
+  //
+  std::queue< std::pair<uint8_t *, ssize_t> > pending;
   {
     CriticalSection cs (m_pendingReadMutex);
-    std::pair<uint8_t *, ssize_t> next = m_pendingQueue.front ();
-    m_pendingQueue.pop ();
-
-    buf = next.first;
-    len = next.second;
+    pending.swap (m_pendingQueue);
+    m_forwardUpScheduled = false;
   }
 
+  while (!pending.empty ())
+    {
+      std::pair<uint8_t *, ssize_t> next = pending.front ();
+      pending.pop ();
+      ForwardUpFrame (next.first, next.second);
+    }
+}
+
+void
+FdNetDevice::ForwardUpFrame (uint8_t *buf, ssize_t len)
+{
   NS_LOG_FUNCTION (this << buf << len);
 
-  // We need to remove the PI header and ignore it
-  if (m_encapMode == DIXPI)
+  // We need to skip the PI header and ignore it
+  const uint8_t *frame = buf;
+  if (m_encapMode == DIXPI && len >= 4)
     {
-      RemovePIHeader (buf, len);
+      frame += 4;
+      len -= 4;
     }
 
   //
   // Create a packet out of the buffer we received and free that buffer.
   //
-  Ptr<Packet> packet = Create<Packet> (reinterpret_cast<const uint8_t *> (buf), len);
+  Ptr<Packet> packet = Create<Packet> (frame, len);
   free (buf);
   buf = 0;
 
@@ -577,18 +569,27 @@ FdNetDevice::SendFrom (Ptr<Packet> packet, const Address& src, const Address& de
   NS_LOG_LOGIC ("calling write");
 
 
+  //
+  // The frame is copied in a buffer kept across the calls, after four bytes
+  // left for the PI header if needed.
+  //
   size_t len =  (size_t) packet->GetSize ();
-  uint8_t *buffer = (uint8_t*)malloc (len);
-  packet->CopyData (buffer, len);
+  size_t offset = (m_encapMode == DIXPI) ? 4 : 0;
+  if (m_txBuffer.size () < len + offset)
+    {
+      m_txBuffer.resize (len + offset);
+    }
+  uint8_t *buffer = &m_txBuffer[0];
+  packet->CopyData (buffer + offset, len);
 
   // We need to add the PI header
   if (m_encapMode == DIXPI)
     {
       AddPIHeader (buffer, len);
+      len += 4;
     }
 
   ssize_t written = write (m_fd, buffer, len);
-  free (buffer);
 
   if (written == -1 || (size_t) written != len)
     {
@@ -38,6 +38,7 @@
 
 #include <utility>
 #include <queue>
+#include <vector>
 
 namespace ns3 {
 
@@ -215,10 +216,17 @@ private:
   void ReceiveCallback (uint8_t *buf, ssize_t len);
 
   /**
-   * Forward the frame to the appropriate callback for processing
+   * Forward all the pending frames to the appropriate callback for processing
    */
   void ForwardUp (void);
 
+  /**
+   * Forward a frame to the appropriate callback for processing
+   * \param buf the buffer holding the frame, freed by this method
+   * \param len the buffer length
+   */
+  void ForwardUpFrame (uint8_t *buf, ssize_t len);
+
   /**
    * Start Sending a Packet Down the Wire.
    * @param p packet to send
@@ -311,6 +319,17 @@ private:
    */
   SystemMutex m_pendingReadMutex;
 
+  /**
+   * Whether an event is scheduled to forward the pending frames, protected
+   * by m_pendingReadMutex.
+   */
+  bool m_forwardUpScheduled;
+
+  /**
+   * Buffer reused to write the frames to the file descriptor.
+   */
+  std::vector<uint8_t> m_txBuffer;
+
   /**
    * Time to start spinning up the device
    */
@@ -22,6 +22,9 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
 #include <fstream>
 #include <sstream>
 
@@ -48,6 +51,11 @@ FlowMonitor::GetTypeId (void)
                    TimeValue (Seconds (10.0)),
                    MakeTimeAccessor (&FlowMonitor::m_maxPerHopDelay),
                    MakeTimeChecker ())
+    .AddAttribute ("MaxTrackedPackets", ("The maximum number of packets tracked at the same time (0 means no limit).  "
+                                         "When the limit is exceeded, the packet not seen for the longest time is considered lost."),
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&FlowMonitor::m_maxTrackedPackets),
+                   MakeUintegerChecker<uint32_t> ())
     .AddAttribute ("StartTime", ("The time when the monitoring starts."),
                    TimeValue (Seconds (0.0)),
                    MakeTimeAccessor (&FlowMonitor::Start),
@@ -72,6 +80,24 @@ FlowMonitor::GetTypeId (void)
                    TimeValue (Seconds (0.5)),
                    MakeTimeAccessor (&FlowMonitor::m_flowInterruptionsMinTime),
                    MakeTimeChecker ())
+    .AddAttribute ("StreamFileName", ("Name of the CSV file flow statistics are streamed to while the simulation runs.  "
+                                      "If empty, streaming is disabled and all the flows are kept in memory."),
+                   StringValue (""),
+                   MakeStringAccessor (&FlowMonitor::SetStreamFileName),
+                   MakeStringChecker ())
+    .AddAttribute ("StreamInterval", ("The interval between two exports of flow statistics to the stream."),
+                   TimeValue (Seconds (1.0)),
+                   MakeTimeAccessor (&FlowMonitor::SetStreamInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("FlowIdleTimeout", ("The time without packets after which a flow is considered finished, "
+                                       "written to the stream and evicted from memory."),
+                   TimeValue (Seconds (30.0)),
+                   MakeTimeAccessor (&FlowMonitor::m_flowIdleTimeout),
+                   MakeTimeChecker ())
+    .AddAttribute ("StreamActiveFlows", ("If true, a snapshot of the flows still active is also written to the stream at every export."),
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&FlowMonitor::m_streamActiveFlows),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -83,7 +109,9 @@ FlowMonitor::GetInstanceTypeId (void) const
 }
 
 FlowMonitor::FlowMonitor ()
-  : m_enabled (false)
+  : m_maxTrackedPackets (0),
+    m_enabled (false),
+    m_streamActiveFlows (false)
 {
   // m_histogramBinWidth=DEFAULT_BIN_WIDTH;
 }
@@ -102,6 +130,11 @@ FlowMonitor::DoDispose (void)
       m_flowProbes[i]->Dispose ();
       m_flowProbes[i] = 0;
     }
+  m_streamEvent.Cancel ();
+  if (m_stream.is_open ())
+    {
+      m_stream.close ();
+    }
   Object::DoDispose ();
 }
 
@@ -143,10 +176,20 @@ FlowMonitor::ReportFirstTx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t pack
       return;
     }
   Time now = Simulator::Now ();
-  TrackedPacket &tracked = m_trackedPackets[std::make_pair (flowId, packetId)];
+  TrackedPacketKey key (flowId, packetId);
+  std::pair<TrackedPacketMap::iterator, bool> inserted = m_trackedPackets.insert (std::make_pair (key, TrackedPacket ()));
+  TrackedPacket &tracked = inserted.first->second;
   tracked.firstSeenTime = now;
   tracked.lastSeenTime = tracked.firstSeenTime;
   tracked.timesForwarded = 0;
+  if (inserted.second)
+    {
+      tracked.age = m_trackedPacketsAge.insert (m_trackedPacketsAge.end (), key);
+    }
+  else
+    {
+      m_trackedPacketsAge.splice (m_trackedPacketsAge.end (), m_trackedPacketsAge, tracked.age);
+    }
   NS_LOG_DEBUG ("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId=" << packetId
                                                                 << ").");
 
@@ -160,6 +203,15 @@ FlowMonitor::ReportFirstTx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t pack
       stats.timeFirstTxPacket = now;
     }
   stats.timeLastTxPacket = now;
+
+  while (m_maxTrackedPackets > 0 && m_trackedPackets.size () > m_maxTrackedPackets)
+    {
+      TrackedPacketMap::iterator oldest = m_trackedPackets.find (m_trackedPacketsAge.front ());
+      NS_ASSERT (oldest != m_trackedPackets.end ());
+      NS_LOG_DEBUG ("ReportFirstTx: too many tracked packets, (flowId=" << oldest->first.first
+                    << ", packetId=" << oldest->first.second << ") considered lost.");
+      MarkTrackedPacketLost (oldest);
+    }
 }
 
 
@@ -181,6 +233,7 @@ FlowMonitor::ReportForwarding (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t p
 
   tracked->second.timesForwarded++;
   tracked->second.lastSeenTime = Simulator::Now ();
+  m_trackedPacketsAge.splice (m_trackedPacketsAge.end (), m_trackedPacketsAge, tracked->second.age);
 
   Time delay = (Simulator::Now () - tracked->second.firstSeenTime);
   probe->AddPacketStats (flowId, packetSize, delay);
@@ -247,7 +300,7 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
   NS_LOG_DEBUG ("ReportLastTx: removing tracked packet (flowId="
                 << flowId << ", packetId=" << packetId << ").");
 
-  m_trackedPackets.erase (tracked); // we don't need to track this packet anymore
+  EraseTrackedPacket (tracked); // we don't need to track this packet anymore
 }
 
 void
@@ -279,7 +332,7 @@ FlowMonitor::ReportDrop (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetI
       // FIXME: this will not necessarily be true with broadcast/multicast
       NS_LOG_DEBUG ("ReportDrop: removing tracked packet (flowId="
                     << flowId << ", packetId=" << packetId << ").");
-      m_trackedPackets.erase (tracked);
+      EraseTrackedPacket (tracked);
     }
 }
 
@@ -290,28 +343,39 @@ FlowMonitor::GetFlowStats () const
 }
 
 
+void
+FlowMonitor::EraseTrackedPacket (TrackedPacketMap::iterator tracked)
+{
+  m_trackedPacketsAge.erase (tracked->second.age);
+  m_trackedPackets.erase (tracked);
+}
+
+void
+FlowMonitor::MarkTrackedPacketLost (TrackedPacketMap::iterator tracked)
+{
+  // the flow may have been evicted by the streaming export; account the
+  // loss to a (possibly new) entry of the flow
+  FlowStats &stats = GetStatsForFlow (tracked->first.first);
+  stats.lostPackets++;
+  EraseTrackedPacket (tracked);
+}
+
 void
 FlowMonitor::CheckForLostPackets (Time maxDelay)
 {
   Time now = Simulator::Now ();
 
-  for (TrackedPacketMap::iterator iter = m_trackedPackets.begin ();
-       iter != m_trackedPackets.end (); )
+  // packets are sorted by last seen time: stop at the first one not expired
+  while (!m_trackedPacketsAge.empty ())
     {
-      if (now - iter->second.lastSeenTime >= maxDelay)
-        {
-          // packet is considered lost, add it to the loss statistics
-          FlowStatsContainerI flow = m_flowStats.find (iter->first.first);
-          NS_ASSERT (flow != m_flowStats.end ());
-          flow->second.lostPackets++;
-
-          // we won't track it anymore
-          m_trackedPackets.erase (iter++);
-        }
-      else
+      TrackedPacketMap::iterator iter = m_trackedPackets.find (m_trackedPacketsAge.front ());
+      NS_ASSERT (iter != m_trackedPackets.end ());
+      if (now - iter->second.lastSeenTime < maxDelay)
         {
-          iter++;
+          break;
         }
+      // packet is considered lost, add it to the loss statistics
+      MarkTrackedPacketLost (iter);
     }
 }
 
@@ -328,6 +392,83 @@ FlowMonitor::PeriodicCheckForLostPackets ()
   Simulator::Schedule (PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
 }
 
+void
+FlowMonitor::WriteStreamRow (FlowId flowId, const FlowStats &stats, bool finished)
+{
+  m_stream << Simulator::Now ().GetSeconds ()
+           << ',' << flowId
+           << ',' << finished
+           << ',' << stats.timeFirstTxPacket.GetSeconds ()
+           << ',' << stats.timeFirstRxPacket.GetSeconds ()
+           << ',' << stats.timeLastTxPacket.GetSeconds ()
+           << ',' << stats.timeLastRxPacket.GetSeconds ()
+           << ',' << stats.delaySum.GetSeconds ()
+           << ',' << stats.jitterSum.GetSeconds ()
+           << ',' << stats.txBytes
+           << ',' << stats.rxBytes
+           << ',' << stats.txPackets
+           << ',' << stats.rxPackets
+           << ',' << stats.lostPackets
+           << ',' << stats.timesForwarded
+           << '\n';
+}
+
+FlowMonitor::FlowStatsContainerI
+FlowMonitor::EvictFlow (FlowStatsContainerI flowI)
+{
+  for (uint32_t i = 0; i < m_flowProbes.size (); i++)
+    {
+      m_flowProbes[i]->RemoveFlowStats (flowI->first);
+    }
+  m_flowStats.erase (flowI++);
+  return flowI;
+}
+
+void
+FlowMonitor::PeriodicStreamExport ()
+{
+  CheckForLostPackets ();
+
+  Time now = Simulator::Now ();
+  for (FlowStatsContainerI flowI = m_flowStats.begin (); flowI != m_flowStats.end (); )
+    {
+      const FlowStats &stats = flowI->second;
+      Time lastActivity = Max (stats.timeLastTxPacket, stats.timeLastRxPacket);
+      if (now - lastActivity >= m_flowIdleTimeout)
+        {
+          NS_LOG_DEBUG ("PeriodicStreamExport: evicting idle flow " << flowI->first);
+          WriteStreamRow (flowI->first, stats, true);
+          flowI = EvictFlow (flowI);
+        }
+      else
+        {
+          if (m_streamActiveFlows)
+            {
+              WriteStreamRow (flowI->first, stats, false);
+            }
+          flowI++;
+        }
+    }
+  m_stream.flush ();
+  m_streamEvent = Simulator::Schedule (m_streamInterval, &FlowMonitor::PeriodicStreamExport, this);
+}
+
+void
+FlowMonitor::FlushStream ()
+{
+  if (!m_stream.is_open ())
+    {
+      return;
+    }
+  CheckForLostPackets ();
+  for (FlowStatsContainerI flowI = m_flowStats.begin (); flowI != m_flowStats.end (); )
+    {
+      WriteStreamRow (flowI->first, flowI->second, true);
+      flowI = EvictFlow (flowI);
+    }
+  m_stream.flush ();
+}
+
 void
 FlowMonitor::NotifyConstructionCompleted ()
 {
@@ -335,6 +476,43 @@ FlowMonitor::NotifyConstructionCompleted ()
   Simulator::Schedule (PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
 }
 
+void
+FlowMonitor::SetStreamFileName (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  if (m_stream.is_open ())
+    {
+      m_stream.close ();
+    }
+  m_streamEvent.Cancel ();
+  m_streamFileName = fileName;
+  if (m_streamFileName.empty ())
+    {
+      return;
+    }
+  m_stream.open (m_streamFileName.c_str (), std::ios::out);
+  if (!m_stream.is_open ())
+    {
+      NS_FATAL_ERROR ("Can't open FlowMonitor stream file " << m_streamFileName);
+    }
+  m_stream << "time,flowId,finished,timeFirstTxPacket,timeFirstRxPacket,"
+           << "timeLastTxPacket,timeLastRxPacket,delaySum,jitterSum,"
+           << "txBytes,rxBytes,txPackets,rxPackets,lostPackets,timesForwarded\n";
+  m_streamEvent = Simulator::Schedule (m_streamInterval, &FlowMonitor::PeriodicStreamExport, this);
+}
+
+void
+FlowMonitor::SetStreamInterval (Time interval)
+{
+  NS_LOG_FUNCTION (this << interval);
+  m_streamInterval = interval;
+  if (m_streamEvent.IsRunning ())
+    {
+      m_streamEvent.Cancel ();
+      m_streamEvent = Simulator::Schedule (m_streamInterval, &FlowMonitor::PeriodicStreamExport, this);
+    }
+}
+
 void
 FlowMonitor::AddProbe (Ptr<FlowProbe> probe)
 {
@@ -23,6 +23,8 @@
 
 #include <vector>
 #include <map>
+#include <list>
+#include <fstream>
 
 #include "ns3/ptr.h"
 #include "ns3/object.h"
@@ -46,6 +48,20 @@ namespace ns3 {
  * The FlowMonitor class is responsible for coordinating efforts
  * regarding probes, and collects end-to-end flow statistics.
  *
+ * Packets in transit are kept in a list ordered by the last time they
+ * were seen, so that loss detection only visits the packets that actually
+ * expired.  The attribute MaxTrackedPackets bounds the number of packets
+ * tracked at any time; when the bound is exceeded the packet that has been
+ * silent for the longest time is accounted as lost.
+ *
+ * For long simulations with many flows, the monitor can stream flow
+ * statistics to a CSV file (attribute StreamFileName).  Every
+ * StreamInterval, flows idle for at least FlowIdleTimeout are written to
+ * the file and evicted from memory, together with the per-probe statistics
+ * of those flows.  If StreamActiveFlows is true, a snapshot of the flows
+ * still active is written as well.  A flow which becomes active again after
+ * being evicted is written again later under the same flow id, so the rows
+ * of a flow id must be summed to get its totals.
  */
 class FlowMonitor : public Object
 {
@@ -256,6 +272,11 @@ public:
   /// \param enableProbes if true, include also the per-probe/flow pair statistics in the output
   void SerializeToXmlFile (std::string fileName, bool enableHistograms, bool enableProbes);
 
+  /// Write every flow still held in memory to the stream file (see the
+  /// attribute StreamFileName) and evict it.  This is typically called
+  /// at the end of the simulation.  Does nothing if streaming is disabled.
+  void FlushStream ();
+
 
 protected:
 
@@ -264,20 +285,28 @@ protected:
 
 private:
 
+  /// (FlowId,PacketId) identifying a tracked packet
+  typedef std::pair<FlowId, FlowPacketId> TrackedPacketKey;
+  /// Tracked packets, from the least to the most recently seen
+  typedef std::list<TrackedPacketKey> TrackedPacketAgeList;
+
   /// Structure to represent a single tracked packet data
   struct TrackedPacket
   {
     Time firstSeenTime; //!< absolute time when the packet was first seen by a probe
     Time lastSeenTime; //!< absolute time when the packet was last seen by a probe
     uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
+    TrackedPacketAgeList::iterator age; //!< position of the packet in the age list
   };
 
   /// FlowId --> FlowStats
   FlowStatsContainer m_flowStats;
 
   /// (FlowId,PacketId) --> TrackedPacket
-  typedef std::map< std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
+  typedef std::map<TrackedPacketKey, TrackedPacket> TrackedPacketMap;
   TrackedPacketMap m_trackedPackets; //!< Tracked packets
+  TrackedPacketAgeList m_trackedPacketsAge; //!< Tracked packets sorted by last seen time
+  uint32_t m_maxTrackedPackets; //!< Maximum number of tracked packets (0 means no limit)
   Time m_maxPerHopDelay; //!< Minimum per-hop delay
   FlowProbeContainer m_flowProbes; //!< all the FlowProbes
 
@@ -293,6 +322,13 @@ private:
   double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
   Time m_flowInterruptionsMinTime; //!< Flow interruptions minimum time
 
+  std::string m_streamFileName; //!< CSV file flow statistics are streamed to
+  std::ofstream m_stream;       //!< Output stream of the flow statistics
+  Time m_streamInterval;        //!< Interval between two exports to the stream
+  EventId m_streamEvent;        //!< Next export to the stream
+  Time m_flowIdleTimeout;       //!< Inactivity after which a flow is evicted
+  bool m_streamActiveFlows;     //!< Also write snapshots of the active flows
+
   /// Get the stats for a given flow
   /// \param flowId the Flow identification
   /// \returns the stats of the flow
@@ -300,6 +336,37 @@ private:
 
   /// Periodic function to check for lost packets and prune statistics
   void PeriodicCheckForLostPackets ();
+
+  /// Account a tracked packet as lost and stop tracking it
+  /// \param tracked the tracked packet
+  void MarkTrackedPacketLost (TrackedPacketMap::iterator tracked);
+
+  /// Stop tracking a packet
+  /// \param tracked the tracked packet
+  void EraseTrackedPacket (TrackedPacketMap::iterator tracked);
+
+  /// Open the stream file and start the periodic exports, or stop
+  /// streaming if the name is empty
+  /// \param fileName the name of the CSV file
+  void SetStreamFileName (std::string fileName);
+
+  /// Set the interval between two exports to the stream
+  /// \param interval the interval
+  void SetStreamInterval (Time interval);
+
+  /// Periodic function writing idle flows to the stream and evicting them
+  void PeriodicStreamExport ();
+
+  /// Write the statistics of a flow as a CSV row of the stream
+  /// \param flowId the Flow identification
+  /// \param stats the stats of the flow
+  /// \param finished true if the flow is being evicted
+  void WriteStreamRow (FlowId flowId, const FlowStats &stats, bool finished);
+
+  /// Evict a flow from the monitor and from all the probes
+  /// \param flowI the flow to evict
+  /// \returns an iterator to the next flow
+  FlowStatsContainerI EvictFlow (FlowStatsContainerI flowI);
 };
 
 
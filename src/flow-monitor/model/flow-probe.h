@@ -96,6 +96,11 @@ public:
   /// \returns the partial flow statistics
   Stats GetStats () const;
 
+  /// Forget the partial statistics of a flow, e.g. because the flow has
+  /// been exported and evicted by the FlowMonitor.
+  /// \param flowId the flow Identifier
+  void RemoveFlowStats (FlowId flowId);
+
   /// Serializes the results to an std::ostream in XML format
   /// \param os the output stream
   /// \param indent number of spaces to use as base indentation level
@@ -30,6 +30,9 @@ namespace ns3 {
 const uint8_t TCP_PROT_NUMBER = 6;  //!< TCP Protocol number
 const uint8_t UDP_PROT_NUMBER = 17; //!< UDP Protocol number
 
+/// Initial number of slots of the flow hash table
+const uint32_t INITIAL_TABLE_SIZE = 64;
+
 
 
 bool operator < (const Ipv4FlowClassifier::FiveTuple &t1,
@@ -95,8 +98,74 @@ bool operator == (const Ipv4FlowClassifier::FiveTuple &t1,
 
 
 
+/**
+ * \brief Mix a 32-bit word into a running hash (MurmurHash3 round)
+ *
+ * \param h the running hash
+ * \param k the word to mix
+ * \returns the updated hash
+ */
+static inline uint32_t
+MixWord (uint32_t h, uint32_t k)
+{
+  k *= 0xcc9e2d51;
+  k = (k << 15) | (k >> 17);
+  k *= 0x1b873593;
+  h ^= k;
+  h = (h << 13) | (h >> 19);
+  return h * 5 + 0xe6546b64;
+}
+
 Ipv4FlowClassifier::Ipv4FlowClassifier ()
+  : m_table (INITIAL_TABLE_SIZE)
 {
+  for (std::vector<Slot>::iterator iter = m_table.begin (); iter != m_table.end (); iter++)
+    {
+      iter->hash = 0;
+      iter->index = 0;
+    }
+}
+
+uint32_t
+Ipv4FlowClassifier::HashFiveTuple (const FiveTuple &tuple)
+{
+  uint32_t h = tuple.protocol;
+  h = MixWord (h, tuple.sourceAddress.Get ());
+  h = MixWord (h, tuple.destinationAddress.Get ());
+  h = MixWord (h, (static_cast<uint32_t> (tuple.sourcePort) << 16) | tuple.destinationPort);
+  // final avalanche
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  return h;
+}
+
+void
+Ipv4FlowClassifier::GrowTable (void)
+{
+  std::vector<Slot> table (m_table.size () * 2);
+  for (std::vector<Slot>::iterator iter = table.begin (); iter != table.end (); iter++)
+    {
+      iter->hash = 0;
+      iter->index = 0;
+    }
+  uint32_t mask = table.size () - 1;
+  for (std::vector<Slot>::const_iterator iter = m_table.begin (); iter != m_table.end (); iter++)
+    {
+      if (iter->index == 0)
+        {
+          continue;
+        }
+      uint32_t pos = iter->hash & mask;
+      while (table[pos].index != 0)
+        {
+          pos = (pos + 1) & mask;
+        }
+      table[pos] = *iter;
+    }
+  m_table.swap (table);
 }
 
 bool
@@ -146,24 +215,42 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
   tuple.sourcePort = srcPort;
   tuple.destinationPort = dstPort;
 
-  // try to insert the tuple, but check if it already exists
-  std::pair<std::map<FiveTuple, FlowId>::iterator, bool> insert
-    = m_flowMap.insert (std::pair<FiveTuple, FlowId> (tuple, 0));
-
-  // if the insertion succeeded, we need to assign this tuple a new flow identifier
-  if (insert.second)
+  // look for the tuple, linearly probing from its hash slot
+  uint32_t hash = HashFiveTuple (tuple);
+  uint32_t mask = m_table.size () - 1;
+  uint32_t pos = hash & mask;
+  while (m_table[pos].index != 0)
     {
-      FlowId newFlowId = GetNewFlowId ();
-      insert.first->second = newFlowId;
-      m_flowPktIdMap[newFlowId] = 0;
+      if (m_table[pos].hash == hash)
+        {
+          FlowEntry &flow = m_flows[m_table[pos].index - 1];
+          if (flow.tuple == tuple)
+            {
+              *out_flowId = flow.flowId;
+              *out_packetId = flow.nextPacketId++;
+              return true;
+            }
+        }
+      pos = (pos + 1) & mask;
     }
-  else
+
+  // not found: we need to assign this tuple a new flow identifier
+  FlowEntry flow;
+  flow.tuple = tuple;
+  flow.flowId = GetNewFlowId ();
+  flow.nextPacketId = 1;
+  m_flows.push_back (flow);
+  m_table[pos].hash = hash;
+  m_table[pos].index = m_flows.size ();
+
+  // keep the load factor below 1/2
+  if (m_flows.size () * 2 > m_table.size ())
     {
-      m_flowPktIdMap[insert.first->second] ++;
+      GrowTable ();
     }
 
-  *out_flowId = insert.first->second;
-  *out_packetId = m_flowPktIdMap[*out_flowId];
+  *out_flowId = flow.flowId;
+  *out_packetId = 0;
 
   return true;
 }
@@ -172,13 +259,24 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
 Ipv4FlowClassifier::FiveTuple
 Ipv4FlowClassifier::FindFlow (FlowId flowId) const
 {
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  // flow identifiers are assigned in increasing order
+  uint32_t low = 0;
+  uint32_t high = m_flows.size ();
+  while (low < high)
     {
-      if (iter->second == flowId)
+      uint32_t mid = low + (high - low) / 2;
+      if (m_flows[mid].flowId < flowId)
         {
-          return iter->first;
+          low = mid + 1;
         }
+      else
+        {
+          high = mid;
+        }
+    }
+  if (low < m_flows.size () && m_flows[low].flowId == flowId)
+    {
+      return m_flows[low].tuple;
     }
   NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
   FiveTuple retval = { Ipv4Address::GetZero (), Ipv4Address::GetZero (), 0, 0, 0 };
@@ -193,16 +291,16 @@ Ipv4FlowClassifier::SerializeToXmlStream (std::ostream &os, int indent) const
   INDENT (indent); os << "<Ipv4FlowClassifier>\n";
 
   indent += 2;
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  for (std::vector<FlowEntry>::const_iterator
+       iter = m_flows.begin (); iter != m_flows.end (); iter++)
     {
       INDENT (indent);
-      os << "<Flow flowId=\"" << iter->second << "\""
-         << " sourceAddress=\"" << iter->first.sourceAddress << "\""
-         << " destinationAddress=\"" << iter->first.destinationAddress << "\""
-         << " protocol=\"" << int(iter->first.protocol) << "\""
-         << " sourcePort=\"" << iter->first.sourcePort << "\""
-         << " destinationPort=\"" << iter->first.destinationPort << "\""
+      os << "<Flow flowId=\"" << iter->flowId << "\""
+         << " sourceAddress=\"" << iter->tuple.sourceAddress << "\""
+         << " destinationAddress=\"" << iter->tuple.destinationAddress << "\""
+         << " protocol=\"" << int(iter->tuple.protocol) << "\""
+         << " sourcePort=\"" << iter->tuple.sourcePort << "\""
+         << " destinationPort=\"" << iter->tuple.destinationPort << "\""
          << " />\n";
     }
 
@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 #include <map>
+#include <vector>
 
 #include "ns3/ipv4-header.h"
 #include "ns3/flow-classifier.h"
@@ -35,6 +36,10 @@ class Packet;
 /// From these packet headers, a tuple (source-ip, destination-ip,
 /// protocol, source-port, destination-port) is created, and a unique
 /// flow identifier is assigned for each different tuple combination
+///
+/// The tuples are stored in an open-addressing hash table (linear
+/// probing, cached hashes), so that classifying a packet costs a single
+/// probe sequence instead of several tree lookups.
 class Ipv4FlowClassifier : public FlowClassifier
 {
 public:
@@ -73,10 +78,33 @@ public:
 
 private:
 
-  /// Map to Flows Identifiers to FlowIds
-  std::map<FiveTuple, FlowId> m_flowMap;
-  /// Map to FlowIds to FlowPacketId
-  std::map<FlowId, FlowPacketId> m_flowPktIdMap;
+  /// A flow known to the classifier
+  struct FlowEntry
+  {
+    FiveTuple tuple;            //!< Flow five-tuple
+    FlowId flowId;              //!< Flow identifier
+    FlowPacketId nextPacketId;  //!< Identifier of the next packet of the flow
+  };
+
+  /// A slot of the hash table
+  struct Slot
+  {
+    uint32_t hash;   //!< Cached hash of the tuple stored in the slot
+    uint32_t index;  //!< Index of the flow in m_flows plus one (0 if the slot is empty)
+  };
+
+  /// Compute the hash of a five-tuple
+  /// \param tuple the five-tuple
+  /// \returns the hash of the tuple
+  static uint32_t HashFiveTuple (const FiveTuple &tuple);
+
+  /// Double the size of the hash table and re-insert all the flows
+  void GrowTable (void);
+
+  /// Flows, in increasing FlowId order
+  std::vector<FlowEntry> m_flows;
+  /// Open-addressing hash table of the flows (size is a power of two)
+  std::vector<Slot> m_table;
 
 };
 
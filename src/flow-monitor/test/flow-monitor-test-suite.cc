@@ -0,0 +1,262 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * A probe reporting events directly to the monitor, without any
+ * packet or network stack.
+ */
+class DummyFlowProbe : public FlowProbe
+{
+public:
+  DummyFlowProbe (Ptr<FlowMonitor> monitor)
+    : FlowProbe (monitor)
+  {
+  }
+};
+
+/**
+ * Check the loss detection of tracked packets, with and without a bound on
+ * the number of tracked packets.
+ */
+class FlowMonitorLossTestCase : public TestCase
+{
+public:
+  FlowMonitorLossTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /// Check the number of lost packets of flow 1
+  /// \param expected expected number of lost packets
+  void CheckLost (uint32_t expected);
+
+  Ptr<FlowMonitor> m_monitor; //!< the monitor under test
+};
+
+FlowMonitorLossTestCase::FlowMonitorLossTestCase ()
+  : TestCase ("FlowMonitor loss detection")
+{
+}
+
+void
+FlowMonitorLossTestCase::CheckLost (uint32_t expected)
+{
+  m_monitor->CheckForLostPackets ();
+  const FlowMonitor::FlowStatsContainer &stats = m_monitor->GetFlowStats ();
+  NS_TEST_ASSERT_MSG_EQ (stats.size (), 1, "Unexpected number of flows");
+  NS_TEST_EXPECT_MSG_EQ (stats.begin ()->second.lostPackets, expected,
+                         "Unexpected number of lost packets at " << Simulator::Now ().GetSeconds ());
+}
+
+void
+FlowMonitorLossTestCase::DoRun (void)
+{
+  m_monitor = CreateObjectWithAttributes<FlowMonitor> ("MaxPerHopDelay", TimeValue (Seconds (1)));
+  Ptr<FlowProbe> probe = Create<DummyFlowProbe> (m_monitor);
+  m_monitor->StartRightNow ();
+
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      m_monitor->ReportFirstTx (probe, 1, i, 100);
+    }
+  Simulator::Schedule (Seconds (0.1), &FlowMonitor::ReportLastRx, m_monitor, probe, 1, 0, 100);
+  Simulator::Schedule (Seconds (0.8), &FlowMonitor::ReportForwarding, m_monitor, probe, 1, 5, 100);
+  Simulator::Schedule (Seconds (0.9), &FlowMonitor::ReportDrop, m_monitor, probe, 1, 6, 100, 0);
+  Simulator::Schedule (Seconds (0.5), &FlowMonitorLossTestCase::CheckLost, this, 0);
+  Simulator::Schedule (Seconds (1.5), &FlowMonitorLossTestCase::CheckLost, this, 8);
+  Simulator::Schedule (Seconds (2.0), &FlowMonitorLossTestCase::CheckLost, this, 9);
+  Simulator::Stop (Seconds (2.5));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // Bounded table: the oldest packets are considered lost
+  m_monitor = CreateObjectWithAttributes<FlowMonitor> ("MaxTrackedPackets", UintegerValue (4));
+  probe = Create<DummyFlowProbe> (m_monitor);
+  m_monitor->StartRightNow ();
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      m_monitor->ReportFirstTx (probe, 1, i, 100);
+    }
+  m_monitor->ReportLastRx (probe, 1, 9, 100);
+  const FlowMonitor::FlowStats &flow = m_monitor->GetFlowStats ().begin ()->second;
+  NS_TEST_EXPECT_MSG_EQ (flow.lostPackets, 6, "Packets beyond the bound not accounted as lost");
+  NS_TEST_EXPECT_MSG_EQ (flow.rxPackets, 1, "Most recent packet no longer tracked");
+  Simulator::Destroy ();
+  m_monitor = 0;
+}
+
+/**
+ * Check that idle flows are written to the stream file and evicted from
+ * the monitor and its probes.
+ */
+class FlowMonitorStreamTestCase : public TestCase
+{
+public:
+  FlowMonitorStreamTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /// Check that only flow 2 is still in memory
+  void CheckEviction ();
+
+  Ptr<FlowMonitor> m_monitor; //!< the monitor under test
+  Ptr<FlowProbe> m_probe;     //!< the probe reporting the events
+};
+
+FlowMonitorStreamTestCase::FlowMonitorStreamTestCase ()
+  : TestCase ("FlowMonitor streaming export")
+{
+}
+
+void
+FlowMonitorStreamTestCase::CheckEviction ()
+{
+  const FlowMonitor::FlowStatsContainer &stats = m_monitor->GetFlowStats ();
+  NS_TEST_ASSERT_MSG_EQ (stats.size (), 1, "Idle flow not evicted");
+  NS_TEST_EXPECT_MSG_EQ (stats.begin ()->first, 2, "Wrong flow evicted");
+  NS_TEST_EXPECT_MSG_EQ (stats.begin ()->second.txPackets, 1, "Flow 2 should restart from scratch");
+  NS_TEST_EXPECT_MSG_EQ (m_probe->GetStats ().count (1), 0, "Probe still holds evicted flow");
+}
+
+void
+FlowMonitorStreamTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("flow-monitor-stream.csv");
+  m_monitor = CreateObjectWithAttributes<FlowMonitor> ("MaxPerHopDelay", TimeValue (Seconds (1)),
+                                                       "FlowIdleTimeout", TimeValue (Seconds (2)));
+  // streaming can be enabled after the creation of the monitor
+  m_monitor->SetAttribute ("StreamFileName", StringValue (fileName));
+  m_monitor->SetAttribute ("StreamInterval", TimeValue (Seconds (1)));
+  m_probe = Create<DummyFlowProbe> (m_monitor);
+  m_monitor->StartRightNow ();
+
+  m_monitor->ReportFirstTx (m_probe, 1, 0, 100);
+  m_monitor->ReportFirstTx (m_probe, 2, 0, 100);
+  Simulator::Schedule (Seconds (0.1), &FlowMonitor::ReportLastRx, m_monitor, m_probe, 2, 0, 100);
+  Simulator::Schedule (Seconds (3.5), &FlowMonitor::ReportFirstTx, m_monitor, m_probe, 2, 1, 100);
+  Simulator::Schedule (Seconds (3.7), &FlowMonitorStreamTestCase::CheckEviction, this);
+  Simulator::Stop (Seconds (3.9));
+  Simulator::Run ();
+  m_monitor->FlushStream ();
+  NS_TEST_EXPECT_MSG_EQ (m_monitor->GetFlowStats ().size (), 0, "Flush did not evict all the flows");
+  Simulator::Destroy ();
+  m_monitor->Dispose ();
+  m_monitor = 0;
+  m_probe = 0;
+
+  std::ifstream in (fileName.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (in.is_open (), true, "Stream file not created");
+  std::string line;
+  uint32_t rows = 0;
+  uint32_t lost = 0;
+  std::getline (in, line); // header
+  while (std::getline (in, line))
+    {
+      // the lostPackets field is the second to last one
+      std::string::size_type last = line.rfind (',');
+      std::string::size_type prev = line.rfind (',', last - 1);
+      lost += std::atoi (line.substr (prev + 1, last - prev - 1).c_str ());
+      rows++;
+    }
+  // flow 1 evicted at 2s, flow 2 at 3s and again when flushing
+  NS_TEST_EXPECT_MSG_EQ (rows, 3, "Unexpected number of rows in the stream");
+  NS_TEST_EXPECT_MSG_EQ (lost, 1, "Unexpected number of lost packets in the stream");
+}
+
+/**
+ * Check that the hash-based Ipv4FlowClassifier assigns stable flow and
+ * packet identifiers, including across table growths.
+ */
+class Ipv4FlowClassifierTestCase : public TestCase
+{
+public:
+  Ipv4FlowClassifierTestCase ();
+  virtual void DoRun (void);
+};
+
+Ipv4FlowClassifierTestCase::Ipv4FlowClassifierTestCase ()
+  : TestCase ("Ipv4FlowClassifier flow identification")
+{
+}
+
+void
+Ipv4FlowClassifierTestCase::DoRun (void)
+{
+  Ptr<Ipv4FlowClassifier> classifier = Create<Ipv4FlowClassifier> ();
+  const uint32_t nFlows = 1000;
+
+  for (uint32_t round = 0; round < 3; round++)
+    {
+      for (uint32_t i = 0; i < nFlows; i++)
+        {
+          Ipv4Header ipHeader;
+          ipHeader.SetSource (Ipv4Address (0x0a000000 + i % 100));
+          ipHeader.SetDestination (Ipv4Address (0x0b000000 + i / 100));
+          ipHeader.SetProtocol (i % 2 ? 6 : 17);
+          uint8_t ports[4] = { 0x13, static_cast<uint8_t> (i % 7), 0x27, 0x10 };
+          Ptr<Packet> payload = Create<Packet> (ports, 4);
+
+          FlowId flowId;
+          FlowPacketId packetId;
+          bool classified = classifier->Classify (ipHeader, payload, &flowId, &packetId);
+          NS_TEST_ASSERT_MSG_EQ (classified, true, "Packet not classified");
+          NS_TEST_ASSERT_MSG_EQ (flowId, i + 1, "Unexpected flow id");
+          NS_TEST_ASSERT_MSG_EQ (packetId, round, "Unexpected packet id");
+
+          Ipv4FlowClassifier::FiveTuple tuple = classifier->FindFlow (flowId);
+          NS_TEST_ASSERT_MSG_EQ (tuple.sourceAddress, ipHeader.GetSource (), "Wrong tuple found");
+          NS_TEST_ASSERT_MSG_EQ (tuple.sourcePort, 0x1300 + i % 7, "Wrong tuple found");
+        }
+    }
+
+  Ipv4Header icmp;
+  icmp.SetProtocol (1);
+  FlowId flowId;
+  FlowPacketId packetId;
+  NS_TEST_EXPECT_MSG_EQ (classifier->Classify (icmp, Create<Packet> (8), &flowId, &packetId), false,
+                         "Non TCP/UDP packet classified");
+}
+
+class FlowMonitorTestSuite : public TestSuite
+{
+public:
+  FlowMonitorTestSuite ();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite ()
+  : TestSuite ("flow-monitor", UNIT)
+{
+  AddTestCase (new FlowMonitorLossTestCase, TestCase::QUICK);
+  AddTestCase (new FlowMonitorStreamTestCase, TestCase::QUICK);
+  AddTestCase (new Ipv4FlowClassifierTestCase, TestCase::QUICK);
+}
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite;
@@ -39,6 +39,7 @@
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/pointer.h"
 #include "ns3/trace-source-accessor.h"
 #include "tcp-socket-base.h"
@@ -129,6 +130,23 @@ TcpSocketBase::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&TcpSocketBase::m_limitedTx),
                    MakeBooleanChecker ())
+    .AddAttribute ("Pacing", "Enable pacing of new data at a rate derived from cWnd/RTT",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&TcpSocketBase::m_pacing),
+                   MakeBooleanChecker ())
+    .AddAttribute ("PacingSsRatio", "Pacing rate multiplier of cWnd/RTT in slow start",
+                   DoubleValue (2.0),
+                   MakeDoubleAccessor (&TcpSocketBase::m_pacingSsRatio),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("PacingCaRatio", "Pacing rate multiplier of cWnd/RTT in congestion avoidance",
+                   DoubleValue (1.2),
+                   MakeDoubleAccessor (&TcpSocketBase::m_pacingCaRatio),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("PacingBurst",
+                   "Maximum number of segments sent back-to-back at each pacing timer expiration",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&TcpSocketBase::m_pacingBurst),
+                   MakeUintegerChecker<uint32_t> (1))
     .AddTraceSource ("RTO",
                      "Retransmission timeout",
                      MakeTraceSourceAccessor (&TcpSocketBase::m_rto),
@@ -312,6 +330,11 @@ TcpSocketBase::TcpSocketBase (void)
     m_timestampEnabled (true),
     m_timestampToEcho (0),
     m_sendPendingDataEvent (),
+    m_pacing (false),
+    m_pacingSsRatio (2.0),
+    m_pacingCaRatio (1.2),
+    m_pacingBurst (1),
+    m_pacingEvent (),
     // Set m_recover to the initial sequence number
     m_recover (0),
     m_retxThresh (3),
@@ -389,6 +412,10 @@ TcpSocketBase::TcpSocketBase (const TcpSocketBase& sock)
     m_sndWindShift (sock.m_sndWindShift),
     m_timestampEnabled (sock.m_timestampEnabled),
     m_timestampToEcho (sock.m_timestampToEcho),
+    m_pacing (sock.m_pacing),
+    m_pacingSsRatio (sock.m_pacingSsRatio),
+    m_pacingCaRatio (sock.m_pacingCaRatio),
+    m_pacingBurst (sock.m_pacingBurst),
     m_recover (sock.m_recover),
     m_retxThresh (sock.m_retxThresh),
     m_limitedTx (sock.m_limitedTx),
@@ -2640,7 +2667,15 @@ TcpSocketBase::SendPendingData (bool withAck)
       NS_LOG_INFO ("TcpSocketBase::SendPendingData: No endpoint; m_shutdownSend=" << m_shutdownSend);
       return false; // Is this the right way to handle this condition?
     }
+  if (m_pacing && m_pacingEvent.IsRunning ())
+    {
+      NS_LOG_LOGIC ("Pacing timer running. Wait to send.");
+      return false;
+    }
+  // Pacing needs an RTT estimate; until then data is sent unpaced
+  bool paced = m_pacing && !m_rtt->GetEstimate ().IsZero ();
   uint32_t nPacketsSent = 0;
+  uint32_t nBytesSent = 0;
   while (m_txBuffer->SizeFromSequence (m_tcb->m_nextTxSequence))
     {
       uint32_t w = AvailableWindow (); // Get available window size
@@ -2674,15 +2709,42 @@ TcpSocketBase::SendPendingData (bool withAck)
       uint32_t s = std::min (w, m_tcb->m_segmentSize);  // Send no more than window
       uint32_t sz = SendDataPacket (m_tcb->m_nextTxSequence, s, withAck);
       nPacketsSent++;                             // Count sent this loop
+      nBytesSent += sz;
       m_tcb->m_nextTxSequence += sz;                     // Advance next tx sequence
+      if (paced && nPacketsSent >= m_pacingBurst)
+        {
+          break;
+        }
     }
   if (nPacketsSent > 0)
     {
       NS_LOG_DEBUG ("SendPendingData sent " << nPacketsSent << " segments");
+      if (paced)
+        {
+          Time interval = GetPacingInterval (nBytesSent);
+          NS_LOG_LOGIC ("Next pacing release in " << interval.GetSeconds () << "s");
+          m_pacingEvent = Simulator::Schedule (interval, &TcpSocketBase::SendPendingData,
+                                               this, m_connected);
+        }
     }
   return (nPacketsSent > 0);
 }
 
+Time
+TcpSocketBase::GetPacingInterval (uint32_t bytes) const
+{
+  NS_LOG_FUNCTION (this << bytes);
+  Time srtt = m_rtt->GetEstimate ();
+  double ratio = (m_tcb->m_cWnd < m_tcb->m_ssThresh) ? m_pacingSsRatio : m_pacingCaRatio;
+  if (srtt.IsZero () || ratio <= 0)
+    {
+      return Time (0);
+    }
+  double cWnd = std::max (m_tcb->m_cWnd.Get (), m_tcb->m_segmentSize);
+  // interval = bytes / rate, with rate = ratio * cWnd / srtt
+  return Seconds (bytes * srtt.GetSeconds () / (ratio * cWnd));
+}
+
 uint32_t
 TcpSocketBase::UnAckDataCount () const
 {
@@ -3125,6 +3187,7 @@ TcpSocketBase::CancelAllTimers ()
   m_lastAckEvent.Cancel ();
   m_timewaitEvent.Cancel ();
   m_sendPendingDataEvent.Cancel ();
+  m_pacingEvent.Cancel ();
 }
 
 /* Move TCP to Time_Wait state and schedule a transition to Closed state */
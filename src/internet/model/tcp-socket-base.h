@@ -265,6 +265,18 @@ public:
  *
  * The algorithm is implemented in the ReceivedAck method.
  *
+ * Pacing
+ * --------------------------
+ *
+ * When the attribute "Pacing" is set to true, new data is not released as a
+ * window-sized burst but spread over the RTT at a rate derived from the
+ * congestion window: rate = ratio * cWnd / SRTT, where ratio is
+ * "PacingSsRatio" in slow start and "PacingCaRatio" in congestion avoidance.
+ * Each expiration of the pacing timer releases at most "PacingBurst"
+ * back-to-back segments, so larger bursts trade smoothness for fewer timer
+ * events. Retransmissions are never delayed by the pacing timer. Pacing is
+ * only active once an RTT estimate is available.
+ *
  */
 class TcpSocketBase : public TcpSocket
 {
@@ -618,6 +630,15 @@ protected:
    */
   uint32_t SendDataPacket (SequenceNumber32 seq, uint32_t maxSize, bool withAck);
 
+  /**
+   * \brief Compute the time needed to release some bytes at the pacing rate
+   *
+   * \param bytes the number of bytes just sent
+   * \returns the interval before the next pacing release, or zero if no
+   *          RTT estimate is available yet
+   */
+  Time GetPacingInterval (uint32_t bytes) const;
+
   /**
    * \brief Send a empty packet that carries a flag, e.g. ACK
    *
@@ -1041,6 +1062,13 @@ protected:
 
   EventId m_sendPendingDataEvent; //!< micro-delay event to send pending data
 
+  // Pacing
+  bool     m_pacing;          //!< Pacing of new data enabled
+  double   m_pacingSsRatio;   //!< Pacing rate multiplier in slow start
+  double   m_pacingCaRatio;   //!< Pacing rate multiplier in congestion avoidance
+  uint32_t m_pacingBurst;     //!< Segments released at each pacing timer expiration
+  EventId  m_pacingEvent;     //!< Pacing timer
+
   // Fast Retransmit and Recovery
   SequenceNumber32       m_recover;      //!< Previous highest Tx seqnum for fast recovery
   uint32_t               m_retxThresh;   //!< Fast Retransmit threshold
@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "tcp-general-test.h"
+#include "ns3/node.h"
+#include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TcpPacingTest");
+
+/**
+ * \brief Check that pacing spreads new data over time
+ *
+ * The application writes all its data at once, so without pacing the
+ * sender would release a whole cWnd back-to-back. With pacing enabled, once
+ * an RTT estimate is available no more than "PacingBurst" segments may leave
+ * the sender at the same instant, two releases must be at least the pacing
+ * interval of the first one apart (its bytes over ratio * cWnd / sRTT), and
+ * all the data must still be delivered.
+ *
+ * The same checks are run without pacing, to verify that the spacing is
+ * violated when the sender is not paced.
+ */
+class TcpPacingTestCase : public TcpGeneralTest
+{
+public:
+  TcpPacingTestCase (const std::string &desc, bool pacing, uint32_t burst) :
+    TcpGeneralTest (desc),
+    m_pacing (pacing),
+    m_burst (burst),
+    m_sentBytes (0),
+    m_highestSeq (0),
+    m_lastTx (Seconds (-1)),
+    m_sameInstant (0),
+    m_maxSameInstant (0),
+    m_releaseBytes (0),
+    m_interval (Seconds (0)),
+    m_spacedReleases (0),
+    m_shortGaps (0)
+  { }
+
+protected:
+  virtual Ptr<TcpSocketMsgBase> CreateSenderSocket (Ptr<Node> node);
+
+  virtual void Tx (const Ptr<const Packet> p, const TcpHeader&h, SocketWho who);
+  virtual void ConfigureEnvironment ();
+  virtual void FinalChecks ();
+
+private:
+  /**
+   * \brief Compute the pacing interval following the current release
+   * \return the interval, or zero if the release is not paced
+   */
+  Time GetExpectedInterval ();
+
+  bool     m_pacing;         //!< Pacing enabled on the sender
+  uint32_t m_burst;          //!< Segments allowed back-to-back
+  uint32_t m_sentBytes;      //!< Data bytes sent by the sender
+  SequenceNumber32 m_highestSeq; //!< Highest sequence number sent
+  Time     m_lastTx;         //!< Time of the last data segment
+  uint32_t m_sameInstant;    //!< Segments sent at m_lastTx
+  uint32_t m_maxSameInstant; //!< Largest observed burst
+  uint32_t m_releaseBytes;   //!< Bytes sent at m_lastTx
+  Time     m_interval;       //!< Pacing interval after the release at m_lastTx
+  uint32_t m_spacedReleases; //!< Releases which followed a paced release
+  uint32_t m_shortGaps;      //!< Releases sent before the pacing interval
+};
+
+void
+TcpPacingTestCase::ConfigureEnvironment ()
+{
+  TcpGeneralTest::ConfigureEnvironment ();
+  SetAppPktCount (100);
+  SetAppPktSize (500);
+  SetAppPktInterval (Seconds (0));
+}
+
+Ptr<TcpSocketMsgBase>
+TcpPacingTestCase::CreateSenderSocket (Ptr<Node> node)
+{
+  Ptr<TcpSocketMsgBase> socket = TcpGeneralTest::CreateSenderSocket (node);
+  socket->SetAttribute ("Pacing", BooleanValue (m_pacing));
+  socket->SetAttribute ("PacingBurst", UintegerValue (m_burst));
+  return socket;
+}
+
+void
+TcpPacingTestCase::Tx (const Ptr<const Packet> p, const TcpHeader &h, SocketWho who)
+{
+  NS_LOG_FUNCTION (this << p << h << who);
+
+  if (who != SENDER || p->GetSize () == 0)
+    {
+      return;
+    }
+
+  m_sentBytes += p->GetSize ();
+  // retransmissions are not paced
+  if (h.GetSequenceNumber () < m_highestSeq)
+    {
+      return;
+    }
+  m_highestSeq = h.GetSequenceNumber ();
+
+  if (Simulator::Now () == m_lastTx)
+    {
+      ++m_sameInstant;
+      m_releaseBytes += p->GetSize ();
+    }
+  else
+    {
+      if (!m_interval.IsZero ())
+        {
+          ++m_spacedReleases;
+          if (Simulator::Now () - m_lastTx < m_interval - NanoSeconds (1))
+            {
+              NS_LOG_DEBUG ("Release at " << Simulator::Now ().GetSeconds () <<
+                            " after " << (Simulator::Now () - m_lastTx).GetSeconds () <<
+                            " instead of " << m_interval.GetSeconds ());
+              ++m_shortGaps;
+            }
+        }
+      m_lastTx = Simulator::Now ();
+      m_sameInstant = 1;
+      m_releaseBytes = p->GetSize ();
+    }
+  m_maxSameInstant = std::max (m_maxSameInstant, m_sameInstant);
+  m_interval = GetExpectedInterval ();
+}
+
+Time
+TcpPacingTestCase::GetExpectedInterval ()
+{
+  Time srtt = GetRttEstimator (SENDER)->GetEstimate ();
+  if (srtt.IsZero ())
+    {
+      return Seconds (0);
+    }
+  Ptr<TcpSocketState> tcb = GetTcb (SENDER);
+  DoubleValue ratio;
+  GetSenderSocket ()->GetAttribute (tcb->m_cWnd < tcb->m_ssThresh ? "PacingSsRatio" : "PacingCaRatio",
+                                    ratio);
+  double cWnd = std::max (tcb->m_cWnd.Get (), tcb->m_segmentSize);
+  return Seconds (m_releaseBytes * srtt.GetSeconds () / (ratio.Get () * cWnd));
+}
+
+void
+TcpPacingTestCase::FinalChecks ()
+{
+  NS_TEST_ASSERT_MSG_EQ (m_sentBytes, GetPktSize () * GetPktCount (),
+                         "Pacing prevented some data from being sent");
+  NS_TEST_ASSERT_MSG_GT (m_spacedReleases, 0, "No release followed a paced one");
+  if (m_pacing)
+    {
+      NS_TEST_ASSERT_MSG_LT_OR_EQ (m_maxSameInstant, m_burst,
+                                   "More segments than the pacing burst sent at once");
+      NS_TEST_ASSERT_MSG_EQ (m_shortGaps, 0, "Segments released before the pacing interval");
+    }
+  else
+    {
+      NS_TEST_ASSERT_MSG_GT (m_shortGaps, 0, "Unpaced sender spaced as if paced");
+    }
+}
+
+static class TcpPacingTestSuite : public TestSuite
+{
+public:
+  TcpPacingTestSuite ()
+    : TestSuite ("tcp-pacing", UNIT)
+  {
+    AddTestCase (new TcpPacingTestCase ("Pacing with one segment per release", true, 1), TestCase::QUICK);
+    AddTestCase (new TcpPacingTestCase ("Pacing with two segments per release", true, 2), TestCase::QUICK);
+    AddTestCase (new TcpPacingTestCase ("Pacing with four segments per release", true, 4), TestCase::QUICK);
+    AddTestCase (new TcpPacingTestCase ("No pacing", false, 4), TestCase::QUICK);
+  }
+
+} g_tcpPacingTestSuite;
+
+} // namespace ns3
@@ -219,6 +219,41 @@ static const int TransportBlockSizeTable [110][27] = {
 
 };
 
+/**
+ * Conversions between CQI and MCS, derived once from the spectral
+ * efficiency tables above, so that the schedulers and the CQI feedback
+ * do not search the tables for each RBG and UE.
+ */
+struct CqiMcsTables
+{
+  CqiMcsTables ()
+  {
+    for (int cqi = 0; cqi < 16; cqi++)
+      {
+        int mcs = 0;
+        while ((mcs < 28) && (SpectralEfficiencyForMcs[mcs + 1] <= SpectralEfficiencyForCqi[cqi]))
+          {
+            ++mcs;
+          }
+        mcsForCqi[cqi] = mcs;
+      }
+    for (int mcs = 0; mcs < 29; mcs++)
+      {
+        int cqi = 0;
+        while ((cqi < 15) && (SpectralEfficiencyForCqi[cqi + 1] < SpectralEfficiencyForMcs[mcs]))
+          {
+            ++cqi;
+          }
+        cqiForMcs[mcs] = cqi;
+      }
+  }
+  int mcsForCqi[16]; //!< the largest MCS not more efficient than each CQI
+  int cqiForMcs[29]; //!< the largest CQI less efficient than each MCS
+};
+
+/// The conversions between CQI and MCS
+static const CqiMcsTables g_cqiMcsTables;
+
 
 LteAmc::LteAmc ()
 {
@@ -271,12 +306,7 @@ LteAmc::GetMcsFromCqi (int cqi)
 {
   NS_LOG_FUNCTION (cqi);
   NS_ASSERT_MSG (cqi >= 0 && cqi <= 15, "CQI must be in [0..15] = " << cqi);
-  double spectralEfficiency = SpectralEfficiencyForCqi[cqi];
-  int mcs = 0;
-  while ((mcs < 28) && (SpectralEfficiencyForMcs[mcs + 1] <= spectralEfficiency))
-    {
-      ++mcs;
-    }
+  int mcs = g_cqiMcsTables.mcsForCqi[cqi];
   NS_LOG_LOGIC ("mcs = " << mcs);
   return mcs;
 }
@@ -386,12 +416,7 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
               }
             else
               {
-                double s = SpectralEfficiencyForMcs[mcs];
-                rbgCqi = 0;
-                while ((rbgCqi < 15) && (SpectralEfficiencyForCqi[rbgCqi + 1] < s))
-                {
-                  ++rbgCqi;
-                }
+                rbgCqi = g_cqiMcsTables.cqiForMcs[mcs];
               }
             NS_LOG_DEBUG (this << "\t MCS " << (uint16_t)mcs << "-> CQI " << rbgCqi);
             // fill the cqi vector (per RB basis)
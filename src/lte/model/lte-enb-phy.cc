@@ -240,6 +240,7 @@ LteEnbPhy::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_ueAttached.clear ();
   m_srsUeOffset.clear ();
+  m_dlCtrlTxPsd = 0;
   delete m_enbPhySapProvider;
   delete m_enbCphySapProvider;
   LtePhy::DoDispose ();
@@ -305,6 +306,7 @@ LteEnbPhy::SetTxPower (double pow)
 {
   NS_LOG_FUNCTION (this << pow);
   m_txPower = pow;
+  m_dlCtrlTxPsd = 0;
 }
 
 double
@@ -768,13 +770,23 @@ void
 LteEnbPhy::SendControlChannels (std::list<Ptr<LteControlMessage> > ctrlMsgList)
 {
   NS_LOG_FUNCTION (this << " eNB " << m_cellId << " start tx ctrl frame");
-  // set the current tx power spectral density (full bandwidth)
-  std::vector <int> dlRb;
-  for (uint8_t i = 0; i < m_dlBandwidth; i++)
+  // set the current tx power spectral density (full bandwidth), which
+  // is the same in every subframe
+  if (m_dlCtrlTxPsd == 0)
     {
-      dlRb.push_back (i);
+      m_dlCtrlSubChannels.clear ();
+      for (uint8_t i = 0; i < m_dlBandwidth; i++)
+        {
+          m_dlCtrlSubChannels.push_back (i);
+        }
+      m_listOfDownlinkSubchannel = m_dlCtrlSubChannels;
+      m_dlCtrlTxPsd = CreateTxPowerSpectralDensity ();
+    }
+  else
+    {
+      m_listOfDownlinkSubchannel = m_dlCtrlSubChannels;
     }
-  SetDownlinkSubChannels (dlRb);
+  m_downlinkSpectrumPhy->SetTxPowerSpectralDensity (m_dlCtrlTxPsd);
   NS_LOG_LOGIC (this << " eNB start TX CTRL");
   bool pss = false;
   if ((m_nrSubFrames == 1) || (m_nrSubFrames == 6))
@@ -890,6 +902,7 @@ LteEnbPhy::DoSetBandwidth (uint8_t ulBandwidth, uint8_t dlBandwidth)
   NS_LOG_FUNCTION (this << (uint32_t) ulBandwidth << (uint32_t) dlBandwidth);
   m_ulBandwidth = ulBandwidth;
   m_dlBandwidth = dlBandwidth;
+  m_dlCtrlTxPsd = 0;
 
   static const int Type0AllocationRbg[4] = {
     10,     // RGB size 1
@@ -913,6 +926,7 @@ LteEnbPhy::DoSetEarfcn (uint16_t ulEarfcn, uint16_t dlEarfcn)
   NS_LOG_FUNCTION (this << ulEarfcn << dlEarfcn);
   m_ulEarfcn = ulEarfcn;
   m_dlEarfcn = dlEarfcn;
+  m_dlCtrlTxPsd = 0;
 }
 
 
@@ -360,6 +360,14 @@ private:
 
   std::vector <int> m_dlDataRbMap;
 
+  /**
+   * The full-band downlink subchannels and tx power spectral density of
+   * the control frames, which only depend on the tx power, bandwidth and
+   * EARFCN; computed again after any of them changes.
+   */
+  std::vector <int> m_dlCtrlSubChannels;
+  Ptr<SpectrumValue> m_dlCtrlTxPsd; ///< the tx PSD of the control frames
+
   /// For storing info on future receptions.
   std::vector< std::list<UlDciLteControlMessage> > m_ulDciQueue;
 
@@ -135,6 +135,9 @@ private:
 
   Ptr<const SpectrumValue> m_noise;
 
+  Ptr<SpectrumValue> m_interf; ///< buffer of the interference plus noise of a chunk
+  Ptr<SpectrumValue> m_sinr;   ///< buffer of the SINR of a chunk
+
   Time m_lastChangeTime;     /**< the time of the last change in
                                 m_TotalPower */
 
@@ -25,6 +25,8 @@
 #include <ns3/node-list.h>
 #include <ns3/node.h>
 #include <ns3/simulator.h>
+#include <ns3/boolean.h>
+#include <ns3/tag.h>
 
 #include "lte-rrc-protocol-real.h"
 #include "lte-ue-rrc.h"
@@ -38,11 +40,252 @@ NS_LOG_COMPONENT_DEFINE ("LteRrcProtocolReal");
 
 const Time RRC_REAL_MSG_DELAY = MilliSeconds (0); 
 
+/**
+ * \ingroup lte
+ *
+ * Byte tag of the packets which carry a decoded RRC message instead of
+ * its encoding (see the PassDecodedMessages attribute of the RRC
+ * protocols). Being a byte tag, it follows the message through the RLC
+ * segmentation and reassembly.
+ */
+class RrcPassedMessageTag : public Tag
+{
+public:
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (TagBuffer i) const;
+  virtual void Deserialize (TagBuffer i);
+  virtual void Print (std::ostream &os) const;
+
+  /// \param msgId the identifier of the passed message
+  void SetMsgId (uint32_t msgId);
+  /// \return the identifier of the passed message
+  uint32_t GetMsgId (void) const;
+
+private:
+  uint32_t m_msgId; ///< identifier of the passed message
+};
+
+NS_OBJECT_ENSURE_REGISTERED (RrcPassedMessageTag);
+
+TypeId
+RrcPassedMessageTag::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::RrcPassedMessageTag")
+    .SetParent<Tag> ()
+    .SetGroupName("Lte")
+    .AddConstructor<RrcPassedMessageTag> ()
+  ;
+  return tid;
+}
+
+TypeId
+RrcPassedMessageTag::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+uint32_t
+RrcPassedMessageTag::GetSerializedSize (void) const
+{
+  return 4;
+}
+
+void
+RrcPassedMessageTag::Serialize (TagBuffer i) const
+{
+  i.WriteU32 (m_msgId);
+}
+
+void
+RrcPassedMessageTag::Deserialize (TagBuffer i)
+{
+  m_msgId = i.ReadU32 ();
+}
+
+void
+RrcPassedMessageTag::Print (std::ostream &os) const
+{
+  os << "msgId=" << m_msgId;
+}
+
+void
+RrcPassedMessageTag::SetMsgId (uint32_t msgId)
+{
+  m_msgId = msgId;
+}
+
+uint32_t
+RrcPassedMessageTag::GetMsgId (void) const
+{
+  return m_msgId;
+}
+
+/// A decoded RRC message in transit
+struct RrcPassedMessageBase : public SimpleRefCount<RrcPassedMessageBase>
+{
+  virtual ~RrcPassedMessageBase ()
+  {
+  }
+  int messageType; ///< type of the message in its logical channel
+};
+
+/// A decoded RRC message in transit, of a given type
+template <class M>
+struct RrcPassedMessage : public RrcPassedMessageBase
+{
+  M msg; ///< the message
+};
+
+/*
+ * As for the ideal handover messages, the passed messages are kept in a
+ * global map until they are received. The messages whose packets are lost
+ * stay there until the simulation is destroyed.
+ */
+static std::map<uint32_t, Ptr<RrcPassedMessageBase> > g_rrcPassedMessageMap;
+static uint32_t g_rrcPassedMessageIdCounter = 0;
+static bool g_rrcPassedMessageMapDestroyScheduled = false;
+
+/**
+ * Remove the messages left in the map when the simulation is destroyed,
+ * so that they do not leak into the next simulation run in the process.
+ */
+static void
+ClearRrcPassedMessages (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  g_rrcPassedMessageMap.clear ();
+  g_rrcPassedMessageIdCounter = 0;
+  g_rrcPassedMessageMapDestroyScheduled = false;
+}
+
+/**
+ * Return the message passed with a packet, if any.
+ *
+ * \param p the packet
+ * \param remove whether to remove the message from the map
+ * \return the message, or 0 if the packet holds an encoded message
+ */
+static Ptr<RrcPassedMessageBase>
+FindRrcPassedMessage (Ptr<Packet> p, bool remove)
+{
+  RrcPassedMessageTag tag;
+  if (!p->FindFirstMatchingByteTag (tag))
+    {
+      return 0;
+    }
+  std::map<uint32_t, Ptr<RrcPassedMessageBase> >::iterator it = g_rrcPassedMessageMap.find (tag.GetMsgId ());
+  NS_ASSERT_MSG (it != g_rrcPassedMessageMap.end (), "msgId " << tag.GetMsgId () << " not found");
+  Ptr<RrcPassedMessageBase> passed = it->second;
+  if (remove)
+    {
+      g_rrcPassedMessageMap.erase (it);
+    }
+  return passed;
+}
+
+/**
+ * Create the packet of an RRC message.
+ *
+ * If the message is passed, the packet has the size of the encoded
+ * message but carries only a tag, and the message is passed to the
+ * receiver in-process. For the message types whose encoding has always
+ * the same size, this size is computed only once.
+ *
+ * \param msg the message
+ * \param messageType the type of the message in its logical channel
+ * \param fixedSize whether the encoding of this message type has a fixed size
+ * \param pass whether to pass the message rather than encoding it
+ * \return the packet
+ */
+template <class H, class M>
+static Ptr<Packet>
+EncodeRrcMessage (const M &msg, int messageType, bool fixedSize, bool pass)
+{
+  if (!pass)
+    {
+      H header;
+      header.SetMessage (msg);
+      Ptr<Packet> packet = Create<Packet> ();
+      packet->AddHeader (header);
+      return packet;
+    }
+  static uint32_t fixedSerializedSize = 0;
+  uint32_t serializedSize = fixedSerializedSize;
+  if (serializedSize == 0)
+    {
+      H header;
+      header.SetMessage (msg);
+      serializedSize = header.GetSerializedSize ();
+      if (fixedSize)
+        {
+          fixedSerializedSize = serializedSize;
+        }
+    }
+  Ptr<RrcPassedMessage<M> > passed = Create<RrcPassedMessage<M> > ();
+  passed->messageType = messageType;
+  passed->msg = msg;
+  if (!g_rrcPassedMessageMapDestroyScheduled)
+    {
+      Simulator::ScheduleDestroy (&ClearRrcPassedMessages);
+      g_rrcPassedMessageMapDestroyScheduled = true;
+    }
+  uint32_t msgId = ++g_rrcPassedMessageIdCounter;
+  NS_ASSERT_MSG (g_rrcPassedMessageMap.find (msgId) == g_rrcPassedMessageMap.end (), "msgId " << msgId << " already in use");
+  g_rrcPassedMessageMap[msgId] = passed;
+  Ptr<Packet> packet = Create<Packet> (serializedSize);
+  RrcPassedMessageTag tag;
+  tag.SetMsgId (msgId);
+  packet->AddByteTag (tag);
+  return packet;
+}
+
+/**
+ * \param p the packet of an RRC message
+ * \return the type of the message in its logical channel
+ */
+template <class C>
+static int
+PeekRrcMessageType (Ptr<Packet> p)
+{
+  Ptr<RrcPassedMessageBase> passed = FindRrcPassedMessage (p, false);
+  if (passed != 0)
+    {
+      return passed->messageType;
+    }
+  C channelMessage;
+  p->PeekHeader (channelMessage);
+  return channelMessage.GetMessageType ();
+}
+
+/**
+ * Decode the RRC message of a packet, or take the passed message.
+ *
+ * \param p the packet of the message
+ * \param msg the message
+ */
+template <class H, class M>
+static void
+DecodeRrcMessage (Ptr<Packet> p, M &msg)
+{
+  Ptr<RrcPassedMessageBase> passed = FindRrcPassedMessage (p, true);
+  if (passed != 0)
+    {
+      msg = static_cast<RrcPassedMessage<M> *> (PeekPointer (passed))->msg;
+      return;
+    }
+  H header;
+  p->RemoveHeader (header);
+  msg = header.GetMessage ();
+}
+
 NS_OBJECT_ENSURE_REGISTERED (LteUeRrcProtocolReal);
 
 LteUeRrcProtocolReal::LteUeRrcProtocolReal ()
   :  m_ueRrcSapProvider (0),
-    m_enbRrcSapProvider (0)
+    m_enbRrcSapProvider (0),
+    m_passDecodedMessages (false)
 {
   m_ueRrcSapUser = new MemberLteUeRrcSapUser<LteUeRrcProtocolReal> (this);
   m_completeSetupParameters.srb0SapUser = new LteRlcSpecificLteRlcSapUser<LteUeRrcProtocolReal> (this);
@@ -70,6 +313,13 @@ LteUeRrcProtocolReal::GetTypeId (void)
     .SetParent<Object> ()
     .SetGroupName("Lte")
     .AddConstructor<LteUeRrcProtocolReal> ()
+    .AddAttribute ("PassDecodedMessages",
+                   "If true, the RRC messages sent by this entity are not encoded: "
+                   "their packets have the size of the encoded messages, but the "
+                   "messages themselves are passed in-process to the receiver.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteUeRrcProtocolReal::m_passDecodedMessages),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -110,12 +360,7 @@ LteUeRrcProtocolReal::DoSendRrcConnectionRequest (LteRrcSap::RrcConnectionReques
   m_rnti = m_rrc->GetRnti ();
   SetEnbRrcSapProvider ();
 
-  Ptr<Packet> packet = Create<Packet> ();
-
-  RrcConnectionRequestHeader rrcConnectionRequestHeader;
-  rrcConnectionRequestHeader.SetMessage (msg);
-
-  packet->AddHeader (rrcConnectionRequestHeader);
+  Ptr<Packet> packet = EncodeRrcMessage<RrcConnectionRequestHeader> (msg, 1, true, m_passDecodedMessages);
 
   LteRlcSapProvider::TransmitPdcpPduParameters transmitPdcpPduParameters;
   transmitPdcpPduParameters.pdcpPdu = packet;
@@ -128,12 +373,7 @@ LteUeRrcProtocolReal::DoSendRrcConnectionRequest (LteRrcSap::RrcConnectionReques
 void 
 LteUeRrcProtocolReal::DoSendRrcConnectionSetupCompleted (LteRrcSap::RrcConnectionSetupCompleted msg)
 {
-  Ptr<Packet> packet = Create<Packet> ();
-
-  RrcConnectionSetupCompleteHeader rrcConnectionSetupCompleteHeader;
-  rrcConnectionSetupCompleteHeader.SetMessage (msg);
-
-  packet->AddHeader (rrcConnectionSetupCompleteHeader);
+  Ptr<Packet> packet = EncodeRrcMessage<RrcConnectionSetupCompleteHeader> (msg, 4, true, m_passDecodedMessages);
 
   LtePdcpSapProvider::TransmitPdcpSduParameters transmitPdcpSduParameters;
   transmitPdcpSduParameters.pdcpSdu = packet;
@@ -154,12 +394,7 @@ LteUeRrcProtocolReal::DoSendRrcConnectionReconfigurationCompleted (LteRrcSap::Rr
   m_rnti = m_rrc->GetRnti ();
   SetEnbRrcSapProvider ();
 
-  Ptr<Packet> packet = Create<Packet> ();
-
-  RrcConnectionReconfigurationCompleteHeader rrcConnectionReconfigurationCompleteHeader;
-  rrcConnectionReconfigurationCompleteHeader.SetMessage (msg);
-
-  packet->AddHeader (rrcConnectionReconfigurationCompleteHeader);
+  Ptr<Packet> packet = EncodeRrcMessage<RrcConnectionReconfigurationCompleteHeader> (msg, 2, true, m_passDecodedMessages);
 
   LtePdcpSapProvider::TransmitPdcpSduParameters transmitPdcpSduParameters;
   transmitPdcpSduParameters.pdcpSdu = packet;
@@ -177,12 +412,7 @@ LteUeRrcProtocolReal::DoSendMeasurementReport (LteRrcSap::MeasurementReport msg)
   m_rnti = m_rrc->GetRnti ();
   SetEnbRrcSapProvider ();
 
-  Ptr<Packet> packet = Create<Packet> ();
-
-  MeasurementReportHeader measurementReportHeader;
-  measurementReportHeader.SetMessage (msg);
-
-  packet->AddHeader (measurementReportHeader);
+  Ptr<Packet> packet = EncodeRrcMessage<MeasurementReportHeader> (msg, 1, false, m_passDecodedMessages);
 
   LtePdcpSapProvider::TransmitPdcpSduParameters transmitPdcpSduParameters;
   transmitPdcpSduParameters.pdcpSdu = packet;
@@ -195,12 +425,7 @@ LteUeRrcProtocolReal::DoSendMeasurementReport (LteRrcSap::MeasurementReport msg)
 void 
 LteUeRrcProtocolReal::DoSendRrcConnectionReestablishmentRequest (LteRrcSap::RrcConnectionReestablishmentRequest msg)
 {
-  Ptr<Packet> packet = Create<Packet> ();
-
-  RrcConnectionReestablishmentRequestHeader rrcConnectionReestablishmentRequestHeader;
-  rrcConnectionReestablishmentRequestHeader.SetMessage (msg);
-
-  packet->AddHeader (rrcConnectionReestablishmentRequestHeader);
+  Ptr<Packet> packet = EncodeRrcMessage<RrcConnectionReestablishmentRequestHeader> (msg, 0, true, m_passDecodedMessages);
 
   LteRlcSapProvider::TransmitPdcpPduParameters transmitPdcpPduParameters;
   transmitPdcpPduParameters.pdcpPdu = packet;
@@ -213,12 +438,7 @@ LteUeRrcProtocolReal::DoSendRrcConnectionReestablishmentRequest (LteRrcSap::RrcC
 void 
 LteUeRrcProtocolReal::DoSendRrcConnectionReestablishmentComplete (LteRrcSap::RrcConnectionReestablishmentComplete msg)
 {
-  Ptr<Packet> packet = Create<Packet> ();
-
-  RrcConnectionReestablishmentCompleteHeader rrcConnectionReestablishmentCompleteHeader;
-  rrcConnectionReestablishmentCompleteHeader.SetMessage (msg);
-
-  packet->AddHeader (rrcConnectionReestablishmentCompleteHeader);
+  Ptr<Packet> packet = EncodeRrcMessage<RrcConnectionReestablishmentCompleteHeader> (msg, 3, true, m_passDecodedMessages);
 
   LtePdcpSapProvider::TransmitPdcpSduParameters transmitPdcpSduParameters;
   transmitPdcpSduParameters.pdcpSdu = packet;
@@ -272,16 +492,6 @@ LteUeRrcProtocolReal::SetEnbRrcSapProvider ()
 void
 LteUeRrcProtocolReal::DoReceivePdcpPdu (Ptr<Packet> p)
 {
-  // Get type of message received
-  RrcDlCcchMessage rrcDlCcchMessage;
-  p->PeekHeader (rrcDlCcchMessage);
-
-  // Declare possible headers to receive
-  RrcConnectionReestablishmentHeader rrcConnectionReestablishmentHeader;
-  RrcConnectionReestablishmentRejectHeader rrcConnectionReestablishmentRejectHeader;
-  RrcConnectionSetupHeader rrcConnectionSetupHeader;
-  RrcConnectionRejectHeader rrcConnectionRejectHeader;
-
   // Declare possible messages
   LteRrcSap::RrcConnectionReestablishment rrcConnectionReestablishmentMsg;
   LteRrcSap::RrcConnectionReestablishmentReject rrcConnectionReestablishmentRejectMsg;
@@ -289,30 +499,26 @@ LteUeRrcProtocolReal::DoReceivePdcpPdu (Ptr<Packet> p)
   LteRrcSap::RrcConnectionReject rrcConnectionRejectMsg;
 
   // Deserialize packet and call member recv function with appropiate structure
-  switch ( rrcDlCcchMessage.GetMessageType () )
+  switch (PeekRrcMessageType<RrcDlCcchMessage> (p))
     {
     case 0:
       // RrcConnectionReestablishment
-      p->RemoveHeader (rrcConnectionReestablishmentHeader);
-      rrcConnectionReestablishmentMsg = rrcConnectionReestablishmentHeader.GetMessage ();
+      DecodeRrcMessage<RrcConnectionReestablishmentHeader> (p, rrcConnectionReestablishmentMsg);
       m_ueRrcSapProvider->RecvRrcConnectionReestablishment (rrcConnectionReestablishmentMsg);
       break;
     case 1:
       // RrcConnectionReestablishmentReject
-      p->RemoveHeader (rrcConnectionReestablishmentRejectHeader);
-      rrcConnectionReestablishmentRejectMsg = rrcConnectionReestablishmentRejectHeader.GetMessage ();
+      DecodeRrcMessage<RrcConnectionReestablishmentRejectHeader> (p, rrcConnectionReestablishmentRejectMsg);
       // m_ueRrcSapProvider->RecvRrcConnectionReestablishmentReject (rrcConnectionReestablishmentRejectMsg);
       break;
     case 2:
       // RrcConnectionReject
-      p->RemoveHeader (rrcConnectionRejectHeader);
-      rrcConnectionRejectMsg = rrcConnectionRejectHeader.GetMessage ();
+      DecodeRrcMessage<RrcConnectionRejectHeader> (p, rrcConnectionRejectMsg);
       m_ueRrcSapProvider->RecvRrcConnectionReject (rrcConnectionRejectMsg);
       break;
     case 3:
       // RrcConnectionSetup
-      p->RemoveHeader (rrcConnectionSetupHeader);
-      rrcConnectionSetupMsg = rrcConnectionSetupHeader.GetMessage ();
+      DecodeRrcMessage<RrcConnectionSetupHeader> (p, rrcConnectionSetupMsg);
       m_ueRrcSapProvider->RecvRrcConnectionSetup (rrcConnectionSetupMsg);
       break;
     }
@@ -321,29 +527,19 @@ LteUeRrcProtocolReal::DoReceivePdcpPdu (Ptr<Packet> p)
 void
 LteUeRrcProtocolReal::DoReceivePdcpSdu (LtePdcpSapUser::ReceivePdcpSduParameters params)
 {
-  // Get type of message received
-  RrcDlDcchMessage rrcDlDcchMessage;
-  params.pdcpSdu->PeekHeader (rrcDlDcchMessage);
-
-  // Declare possible headers to receive
-  RrcConnectionReconfigurationHeader rrcConnectionReconfigurationHeader;
-  RrcConnectionReleaseHeader rrcConnectionReleaseHeader;
-
   // Declare possible messages to receive
   LteRrcSap::RrcConnectionReconfiguration rrcConnectionReconfigurationMsg;
   LteRrcSap::RrcConnectionRelease rrcConnectionReleaseMsg;
 
   // Deserialize packet and call member recv function with appropiate structure
-  switch ( rrcDlDcchMessage.GetMessageType () )
+  switch (PeekRrcMessageType<RrcDlDcchMessage> (params.pdcpSdu))
     {
     case 4:
-      params.pdcpSdu->RemoveHeader (rrcConnectionReconfigurationHeader);
-      rrcConnectionReconfigurationMsg = rrcConnectionReconfigurationHeader.GetMessage ();
+      DecodeRrcMessage<RrcConnectionReconfigurationHeader> (params.pdcpSdu, rrcConnectionReconfigurationMsg);
       m_ueRrcSapProvider->RecvRrcConnectionReconfiguration (rrcConnectionReconfigurationMsg);
       break;
     case 5:
-      params.pdcpSdu->RemoveHeader (rrcConnectionReleaseHeader);
-      rrcConnectionReleaseMsg = rrcConnectionReleaseHeader.GetMessage ();
+      DecodeRrcMessage<RrcConnectionReleaseHeader> (params.pdcpSdu, rrcConnectionReleaseMsg);
       //m_ueRrcSapProvider->RecvRrcConnectionRelease (rrcConnectionReleaseMsg);
       break;
     }
@@ -352,7 +548,8 @@ LteUeRrcProtocolReal::DoReceivePdcpSdu (LtePdcpSapUser::ReceivePdcpSduParameters
 NS_OBJECT_ENSURE_REGISTERED (LteEnbRrcProtocolReal);
 
 LteEnbRrcProtocolReal::LteEnbRrcProtocolReal ()
-  :  m_enbRrcSapProvider (0)
+  :  m_enbRrcSapProvider (0),
+    m_passDecodedMessages (false)
 {
   NS_LOG_FUNCTION (this);
   m_enbRrcSapUser = new MemberLteEnbRrcSapUser<LteEnbRrcProtocolReal> (this);
@@ -386,6 +583,13 @@ LteEnbRrcProtocolReal::GetTypeId (void)
     .SetParent<Object> ()
     .SetGroupName("Lte")
     .AddConstructor<LteEnbRrcProtocolReal> ()
+    .AddAttribute ("PassDecodedMessages",
+                   "If true, the RRC messages sent by this entity are not encoded: "
+                   "their packets have the size of the encoded messages, but the "
+                   "messages themselves are passed in-process to the receiver.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteEnbRrcProtocolReal::m_passDecodedMessages),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -536,12 +740,7 @@ LteEnbRrcProtocolReal::DoSendSystemInformation (LteRrcSap::SystemInformation msg
 void 
 LteEnbRrcProtocolReal::DoSendRrcConnectionSetup (uint16_t rnti, LteRrcSap::RrcConnectionSetup msg)
 {
-  Ptr<Packet> packet = Create<Packet> ();
-
-  RrcConnectionSetupHeader rrcConnectionSetupHeader;
-  rrcConnectionSetupHeader.SetMessage (msg);
-
-  packet->AddHeader (rrcConnectionSetupHeader);
+  Ptr<Packet> packet = EncodeRrcMessage<RrcConnectionSetupHeader> (msg, 3, false, m_passDecodedMessages);
 
   LteRlcSapProvider::TransmitPdcpPduParameters transmitPdcpPduParameters;
   transmitPdcpPduParameters.pdcpPdu = packet;
@@ -561,12 +760,7 @@ LteEnbRrcProtocolReal::DoSendRrcConnectionSetup (uint16_t rnti, LteRrcSap::RrcCo
 void 
 LteEnbRrcProtocolReal::DoSendRrcConnectionReject (uint16_t rnti, LteRrcSap::RrcConnectionReject msg)
 {
-  Ptr<Packet> packet = Create<Packet> ();
-
-  RrcConnectionRejectHeader rrcConnectionRejectHeader;
-  rrcConnectionRejectHeader.SetMessage (msg);
-
-  packet->AddHeader (rrcConnectionRejectHeader);
+  Ptr<Packet> packet = EncodeRrcMessage<RrcConnectionRejectHeader> (msg, 2, true, m_passDecodedMessages);
 
   LteRlcSapProvider::TransmitPdcpPduParameters transmitPdcpPduParameters;
   transmitPdcpPduParameters.pdcpPdu = packet;
@@ -579,12 +773,7 @@ LteEnbRrcProtocolReal::DoSendRrcConnectionReject (uint16_t rnti, LteRrcSap::RrcC
 void 
 LteEnbRrcProtocolReal::DoSendRrcConnectionReconfiguration (uint16_t rnti, LteRrcSap::RrcConnectionReconfiguration msg)
 {
-  Ptr<Packet> packet = Create<Packet> ();
-
-  RrcConnectionReconfigurationHeader rrcConnectionReconfigurationHeader;
-  rrcConnectionReconfigurationHeader.SetMessage (msg);
-
-  packet->AddHeader (rrcConnectionReconfigurationHeader);
+  Ptr<Packet> packet = EncodeRrcMessage<RrcConnectionReconfigurationHeader> (msg, 4, false, m_passDecodedMessages);
 
   LtePdcpSapProvider::TransmitPdcpSduParameters transmitPdcpSduParameters;
   transmitPdcpSduParameters.pdcpSdu = packet;
@@ -597,12 +786,7 @@ LteEnbRrcProtocolReal::DoSendRrcConnectionReconfiguration (uint16_t rnti, LteRrc
 void 
 LteEnbRrcProtocolReal::DoSendRrcConnectionReestablishment (uint16_t rnti, LteRrcSap::RrcConnectionReestablishment msg)
 {
-  Ptr<Packet> packet = Create<Packet> ();
-
-  RrcConnectionReestablishmentHeader rrcConnectionReestablishmentHeader;
-  rrcConnectionReestablishmentHeader.SetMessage (msg);
-
-  packet->AddHeader (rrcConnectionReestablishmentHeader);
+  Ptr<Packet> packet = EncodeRrcMessage<RrcConnectionReestablishmentHeader> (msg, 0, false, m_passDecodedMessages);
 
   LteRlcSapProvider::TransmitPdcpPduParameters transmitPdcpPduParameters;
   transmitPdcpPduParameters.pdcpPdu = packet;
@@ -615,12 +799,7 @@ LteEnbRrcProtocolReal::DoSendRrcConnectionReestablishment (uint16_t rnti, LteRrc
 void 
 LteEnbRrcProtocolReal::DoSendRrcConnectionReestablishmentReject (uint16_t rnti, LteRrcSap::RrcConnectionReestablishmentReject msg)
 {
-  Ptr<Packet> packet = Create<Packet> ();
-
-  RrcConnectionReestablishmentRejectHeader rrcConnectionReestablishmentRejectHeader;
-  rrcConnectionReestablishmentRejectHeader.SetMessage (msg);
-
-  packet->AddHeader (rrcConnectionReestablishmentRejectHeader);
+  Ptr<Packet> packet = EncodeRrcMessage<RrcConnectionReestablishmentRejectHeader> (msg, 1, true, m_passDecodedMessages);
 
   LteRlcSapProvider::TransmitPdcpPduParameters transmitPdcpPduParameters;
   transmitPdcpPduParameters.pdcpPdu = packet;
@@ -633,12 +812,7 @@ LteEnbRrcProtocolReal::DoSendRrcConnectionReestablishmentReject (uint16_t rnti,
 void 
 LteEnbRrcProtocolReal::DoSendRrcConnectionRelease (uint16_t rnti, LteRrcSap::RrcConnectionRelease msg)
 {
-  Ptr<Packet> packet = Create<Packet> ();
-
-  RrcConnectionReleaseHeader rrcConnectionReleaseHeader;
-  rrcConnectionReleaseHeader.SetMessage (msg);
-
-  packet->AddHeader (rrcConnectionReleaseHeader);
+  Ptr<Packet> packet = EncodeRrcMessage<RrcConnectionReleaseHeader> (msg, 5, true, m_passDecodedMessages);
 
   LtePdcpSapProvider::TransmitPdcpSduParameters transmitPdcpSduParameters;
   transmitPdcpSduParameters.pdcpSdu = packet;
@@ -651,27 +825,17 @@ LteEnbRrcProtocolReal::DoSendRrcConnectionRelease (uint16_t rnti, LteRrcSap::Rrc
 void
 LteEnbRrcProtocolReal::DoReceivePdcpPdu (uint16_t rnti, Ptr<Packet> p)
 {
-  // Get type of message received
-  RrcUlCcchMessage rrcUlCcchMessage;
-  p->PeekHeader (rrcUlCcchMessage);
-
-  // Declare possible headers to receive
-  RrcConnectionReestablishmentRequestHeader rrcConnectionReestablishmentRequestHeader;
-  RrcConnectionRequestHeader rrcConnectionRequestHeader;
-
   // Deserialize packet and call member recv function with appropiate structure
-  switch ( rrcUlCcchMessage.GetMessageType () )
+  switch (PeekRrcMessageType<RrcUlCcchMessage> (p))
     {
     case 0:
-      p->RemoveHeader (rrcConnectionReestablishmentRequestHeader);
       LteRrcSap::RrcConnectionReestablishmentRequest rrcConnectionReestablishmentRequestMsg;
-      rrcConnectionReestablishmentRequestMsg = rrcConnectionReestablishmentRequestHeader.GetMessage ();
+      DecodeRrcMessage<RrcConnectionReestablishmentRequestHeader> (p, rrcConnectionReestablishmentRequestMsg);
       m_enbRrcSapProvider->RecvRrcConnectionReestablishmentRequest (rnti,rrcConnectionReestablishmentRequestMsg);
       break;
     case 1:
-      p->RemoveHeader (rrcConnectionRequestHeader);
       LteRrcSap::RrcConnectionRequest rrcConnectionRequestMsg;
-      rrcConnectionRequestMsg = rrcConnectionRequestHeader.GetMessage ();
+      DecodeRrcMessage<RrcConnectionRequestHeader> (p, rrcConnectionRequestMsg);
       m_enbRrcSapProvider->RecvRrcConnectionRequest (rnti,rrcConnectionRequestMsg);
       break;
     }
@@ -680,16 +844,6 @@ LteEnbRrcProtocolReal::DoReceivePdcpPdu (uint16_t rnti, Ptr<Packet> p)
 void
 LteEnbRrcProtocolReal::DoReceivePdcpSdu (LtePdcpSapUser::ReceivePdcpSduParameters params)
 {
-  // Get type of message received
-  RrcUlDcchMessage rrcUlDcchMessage;
-  params.pdcpSdu->PeekHeader (rrcUlDcchMessage);
-
-  // Declare possible headers to receive
-  MeasurementReportHeader measurementReportHeader;
-  RrcConnectionReconfigurationCompleteHeader rrcConnectionReconfigurationCompleteHeader;
-  RrcConnectionReestablishmentCompleteHeader rrcConnectionReestablishmentCompleteHeader;
-  RrcConnectionSetupCompleteHeader rrcConnectionSetupCompleteHeader;
-
   // Declare possible messages to receive
   LteRrcSap::MeasurementReport measurementReportMsg;
   LteRrcSap::RrcConnectionReconfigurationCompleted rrcConnectionReconfigurationCompleteMsg;
@@ -697,26 +851,22 @@ LteEnbRrcProtocolReal::DoReceivePdcpSdu (LtePdcpSapUser::ReceivePdcpSduParameter
   LteRrcSap::RrcConnectionSetupCompleted rrcConnectionSetupCompletedMsg;
 
   // Deserialize packet and call member recv function with appropiate structure
-  switch ( rrcUlDcchMessage.GetMessageType () )
+  switch (PeekRrcMessageType<RrcUlDcchMessage> (params.pdcpSdu))
     {
     case 1:
-      params.pdcpSdu->RemoveHeader (measurementReportHeader);
-      measurementReportMsg = measurementReportHeader.GetMessage ();
+      DecodeRrcMessage<MeasurementReportHeader> (params.pdcpSdu, measurementReportMsg);
       m_enbRrcSapProvider->RecvMeasurementReport (params.rnti,measurementReportMsg);
       break;
     case 2:
-      params.pdcpSdu->RemoveHeader (rrcConnectionReconfigurationCompleteHeader);
-      rrcConnectionReconfigurationCompleteMsg = rrcConnectionReconfigurationCompleteHeader.GetMessage ();
+      DecodeRrcMessage<RrcConnectionReconfigurationCompleteHeader> (params.pdcpSdu, rrcConnectionReconfigurationCompleteMsg);
       m_enbRrcSapProvider->RecvRrcConnectionReconfigurationCompleted (params.rnti,rrcConnectionReconfigurationCompleteMsg);
       break;
     case 3:
-      params.pdcpSdu->RemoveHeader (rrcConnectionReestablishmentCompleteHeader);
-      rrcConnectionReestablishmentCompleteMsg = rrcConnectionReestablishmentCompleteHeader.GetMessage ();
+      DecodeRrcMessage<RrcConnectionReestablishmentCompleteHeader> (params.pdcpSdu, rrcConnectionReestablishmentCompleteMsg);
       m_enbRrcSapProvider->RecvRrcConnectionReestablishmentComplete (params.rnti,rrcConnectionReestablishmentCompleteMsg);
       break;
     case 4:
-      params.pdcpSdu->RemoveHeader (rrcConnectionSetupCompleteHeader);
-      rrcConnectionSetupCompletedMsg = rrcConnectionSetupCompleteHeader.GetMessage ();
+      DecodeRrcMessage<RrcConnectionSetupCompleteHeader> (params.pdcpSdu, rrcConnectionSetupCompletedMsg);
       m_enbRrcSapProvider->RecvRrcConnectionSetupCompleted (params.rnti, rrcConnectionSetupCompletedMsg);
       break;
     }
@@ -91,6 +91,12 @@ private:
   LteUeRrcSapUser::SetupParameters m_setupParameters;
   LteUeRrcSapProvider::CompleteSetupParameters m_completeSetupParameters;
 
+  /**
+   * The `PassDecodedMessages` attribute. If true, the messages are passed
+   * in-process instead of being encoded.
+   */
+  bool m_passDecodedMessages;
+
 };
 
 
@@ -152,6 +158,12 @@ private:
   std::map<uint16_t, LteEnbRrcSapUser::SetupUeParameters> m_setupUeParametersMap;
   std::map<uint16_t, LteEnbRrcSapProvider::CompleteSetupUeParameters> m_completeSetupUeParametersMap;
 
+  /**
+   * The `PassDecodedMessages` attribute. If true, the messages are passed
+   * in-process instead of being encoded.
+   */
+  bool m_passDecodedMessages;
+
 };
 
 ///////////////////////////////////////
@@ -1076,44 +1076,73 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
 
 
+  // The UEs which can be scheduled and their transmission parameters do
+  // not change from one RBG to the next: collect them once per TTI, along
+  // with the rate achievable with each CQI in a RBG.
+  struct DlCandidate
+  {
+    std::map <uint16_t, pfsFlowPerf_t>::iterator flow;   // flow statistics of the UE
+    const std::vector <HigherLayerSelected_s> *sbCqi;     // subband CQIs, 0 if none
+    int nLayer;                                           // number of layers
+  };
+  std::vector <DlCandidate> candidates;
+  std::map <uint16_t, pfsFlowPerf_t>::iterator it;
+  for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++)
+    {
+      std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it).first);
+      if ((itRnti != rntiAllocated.end ())||(!HarqProcessAvailability ((*it).first)))
+        {
+          // UE already allocated for HARQ or without HARQ process available -> drop it
+          if (itRnti != rntiAllocated.end ())
+            {
+              NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)(*it).first);
+            }
+          if (!HarqProcessAvailability ((*it).first))
+            {
+              NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << (uint16_t)(*it).first);
+            }
+          continue;
+        }
+      if (LcActivePerFlow ((*it).first) == 0)
+        {
+          continue;
+        }
+      std::map <uint16_t,uint8_t>::iterator itTxMode;
+      itTxMode = m_uesTxMode.find ((*it).first);
+      if (itTxMode == m_uesTxMode.end ())
+        {
+          NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
+        }
+      DlCandidate candidate;
+      candidate.flow = it;
+      candidate.nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
+      std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
+      itCqi = m_a30CqiRxed.find ((*it).first);
+      candidate.sbCqi = (itCqi == m_a30CqiRxed.end ()) ? 0 : &(*itCqi).second.m_higherLayerSelected;
+      candidates.push_back (candidate);
+    }
+  double rateForCqi[16];
+  for (uint8_t cqi = 0; cqi < 16; cqi++)
+    {
+      rateForCqi[cqi] = (m_amc->GetTbSizeFromMcs (m_amc->GetMcsFromCqi (cqi), rbgSize) / 8) / 0.001;   // = TB size / TTI
+    }
+
   for (int i = 0; i < rbgNum; i++)
     {
       NS_LOG_INFO (this << " ALLOCATION for RBG " << i << " of " << rbgNum);
       if (rbgMap.at (i) == false)
         {
-          std::map <uint16_t, pfsFlowPerf_t>::iterator it;
           std::map <uint16_t, pfsFlowPerf_t>::iterator itMax = m_flowStatsDl.end ();
           double rcqiMax = 0.0;
-          for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++)
+          for (std::vector <DlCandidate>::const_iterator itCand = candidates.begin (); itCand != candidates.end (); itCand++)
             {
+              it = (*itCand).flow;
               if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, (*it).first)) == false)
                 continue;
 
-              std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it).first);
-              if ((itRnti != rntiAllocated.end ())||(!HarqProcessAvailability ((*it).first)))
-                {
-                  // UE already allocated for HARQ or without HARQ process available -> drop it
-                  if (itRnti != rntiAllocated.end ())
-                    {
-                      NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)(*it).first);
-                    }
-                  if (!HarqProcessAvailability ((*it).first))
-                    {
-                      NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << (uint16_t)(*it).first);
-                    }
-                  continue;
-                }
-              std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-              itCqi = m_a30CqiRxed.find ((*it).first);
-              std::map <uint16_t,uint8_t>::iterator itTxMode;
-              itTxMode = m_uesTxMode.find ((*it).first);
-              if (itTxMode == m_uesTxMode.end ())
-                {
-                  NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
-                }
-              int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
+              int nLayer = (*itCand).nLayer;
               std::vector <uint8_t> sbCqi;
-              if (itCqi == m_a30CqiRxed.end ())
+              if ((*itCand).sbCqi == 0)
                 {
                   for (uint8_t k = 0; k < nLayer; k++)
                     {
@@ -1122,7 +1151,7 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
                 }
               else
                 {
-                  sbCqi = (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
+                  sbCqi = (*itCand).sbCqi->at (i).m_sbCqi;
                 }
               uint8_t cqi1 = sbCqi.at (0);
               uint8_t cqi2 = 1;
@@ -1133,36 +1162,34 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
               if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
                 {
-                  if (LcActivePerFlow ((*it).first) > 0)
+                  // this UE has data to transmit
+                  double achievableRate = 0.0;
+                  uint8_t mcs = 0;
+                  for (uint8_t k = 0; k < nLayer; k++)
                     {
-                      // this UE has data to transmit
-                      double achievableRate = 0.0;
-                      uint8_t mcs = 0;
-                      for (uint8_t k = 0; k < nLayer; k++)
+                      if (sbCqi.size () > k)
                         {
-                          if (sbCqi.size () > k)
-                            {
-                              mcs = m_amc->GetMcsFromCqi (sbCqi.at (k));
-                            }
-                          else
-                            {
-                              // no info on this subband -> worst MCS
-                              mcs = 0;
-                            }
-                          achievableRate += ((m_amc->GetTbSizeFromMcs (mcs, rbgSize) / 8) / 0.001);   // = TB size / TTI
+                          mcs = m_amc->GetMcsFromCqi (sbCqi.at (k));
+                          achievableRate += rateForCqi[sbCqi.at (k)];
                         }
-
-                      double rcqi = achievableRate / (*it).second.lastAveragedThroughput;
-                      NS_LOG_INFO (this << " RNTI " << (*it).first << " MCS " << (uint32_t)mcs << " achievableRate " << achievableRate << " avgThr " << (*it).second.lastAveragedThroughput << " RCQI " << rcqi);
-
-                      if (rcqi > rcqiMax)
+                      else
                         {
-                          rcqiMax = rcqi;
-                          itMax = it;
+                          // no info on this subband -> worst MCS
+                          mcs = 0;
+                          achievableRate += rateForCqi[0];
                         }
                     }
+
+                  double rcqi = achievableRate / (*it).second.lastAveragedThroughput;
+                  NS_LOG_INFO (this << " RNTI " << (*it).first << " MCS " << (uint32_t)mcs << " achievableRate " << achievableRate << " avgThr " << (*it).second.lastAveragedThroughput << " RCQI " << rcqi);
+
+                  if (rcqi > rcqiMax)
+                    {
+                      rcqiMax = rcqi;
+                      itMax = it;
+                    }
                 }   // end if cqi
-            } // end for m_rlcBufferReq
+            } // end for candidates
 
           if (itMax == m_flowStatsDl.end ())
             {
@@ -27,15 +27,143 @@
 #include <ns3/string.h>
 #include <ns3/double.h>
 #include "ns3/uinteger.h"
+#include <ns3/abort.h>
 #include <fstream>
+#include <cstring>
+#include <sstream>
 #include <ns3/simulator.h>
+#include "ns3/core-config.h"
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("TraceFadingLossModel");
 
 NS_OBJECT_ENSURE_REGISTERED (TraceFadingLossModel);
-  
+
+/// Magic of the binary trace files, followed by the number of RBs and of samples
+static const char FADING_TRACE_MAGIC[8] = {'N', 'S', '3', 'F', 'A', 'D', 'E', '1'};
+
+/**
+ * \return the traces which are currently loaded, by file name and size
+ */
+static std::map<std::string, FadingTrace *> &
+GetLoadedFadingTraces (void)
+{
+  static std::map<std::string, FadingTrace *> traces;
+  return traces;
+}
+
+FadingTrace::FadingTrace (std::string key, uint8_t rbNum, uint32_t samplesNum)
+  : m_key (key),
+    m_rbNum (rbNum),
+    m_samplesNum (samplesNum),
+    m_samples (0),
+    m_mapping (0),
+    m_mappingSize (0)
+{
+}
+
+FadingTrace::~FadingTrace ()
+{
+  NS_LOG_FUNCTION (this << m_key);
+  GetLoadedFadingTraces ().erase (m_key);
+#ifdef HAVE_SYS_MMAN_H
+  if (m_mapping != 0)
+    {
+      munmap (m_mapping, m_mappingSize);
+    }
+#endif
+}
+
+Ptr<const FadingTrace>
+FadingTrace::Get (std::string fileName, uint8_t rbNum, uint32_t samplesNum)
+{
+  std::ostringstream key;
+  key << fileName << " " << static_cast<uint32_t> (rbNum) << " " << samplesNum;
+  std::map<std::string, FadingTrace *>::const_iterator it = GetLoadedFadingTraces ().find (key.str ());
+  if (it != GetLoadedFadingTraces ().end ())
+    {
+      return it->second;
+    }
+  Ptr<FadingTrace> trace = Ptr<FadingTrace> (new FadingTrace (key.str (), rbNum, samplesNum), false);
+  if (!trace->LoadBinary (fileName))
+    {
+      trace->LoadAscii (fileName);
+    }
+  GetLoadedFadingTraces ()[key.str ()] = PeekPointer (trace);
+  return trace;
+}
+
+bool
+FadingTrace::LoadBinary (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  std::ifstream is (fileName.c_str (), std::ifstream::binary);
+  NS_ABORT_MSG_UNLESS (is.good (), "Fading trace file " << fileName << " not found");
+  char magic[sizeof (FADING_TRACE_MAGIC)];
+  uint32_t rbNum = 0;
+  uint32_t samplesNum = 0;
+  is.read (magic, sizeof (magic));
+  if (!is || std::memcmp (magic, FADING_TRACE_MAGIC, sizeof (magic)) != 0)
+    {
+      return false;
+    }
+  is.read (reinterpret_cast<char *> (&rbNum), sizeof (rbNum));
+  is.read (reinterpret_cast<char *> (&samplesNum), sizeof (samplesNum));
+  NS_ABORT_MSG_UNLESS (is && rbNum == m_rbNum && samplesNum == m_samplesNum,
+                       "Fading trace " << fileName << " has " << rbNum << " RBs and " << samplesNum
+                       << " samples, expected " << static_cast<uint32_t> (m_rbNum) << " and " << m_samplesNum);
+  size_t dataSize = static_cast<size_t> (m_rbNum) * m_samplesNum * sizeof (double);
+#ifdef HAVE_SYS_MMAN_H
+  size_t headerSize = sizeof (FADING_TRACE_MAGIC) + 2 * sizeof (uint32_t);
+  int fd = open (fileName.c_str (), O_RDONLY);
+  struct stat st;
+  if (fd >= 0 && fstat (fd, &st) == 0 && static_cast<size_t> (st.st_size) >= headerSize + dataSize)
+    {
+      void *mapping = mmap (0, headerSize + dataSize, PROT_READ, MAP_SHARED, fd, 0);
+      if (mapping != MAP_FAILED)
+        {
+          m_mapping = mapping;
+          m_mappingSize = headerSize + dataSize;
+          m_samples = reinterpret_cast<const double *> (static_cast<const char *> (mapping) + headerSize);
+        }
+    }
+  if (fd >= 0)
+    {
+      close (fd);
+    }
+  if (m_mapping != 0)
+    {
+      NS_LOG_INFO ("Mapped fading trace " << fileName);
+      return true;
+    }
+#endif
+  m_storage.resize (static_cast<size_t> (m_rbNum) * m_samplesNum);
+  is.read (reinterpret_cast<char *> (&m_storage[0]), dataSize);
+  NS_ABORT_MSG_UNLESS (is, "Fading trace " << fileName << " is truncated");
+  m_samples = &m_storage[0];
+  return true;
+}
+
+void
+FadingTrace::LoadAscii (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  std::ifstream ifTraceFile (fileName.c_str (), std::ifstream::in);
+  NS_ABORT_MSG_UNLESS (ifTraceFile.good (), "Fading trace file " << fileName << " not found");
+  m_storage.resize (static_cast<size_t> (m_rbNum) * m_samplesNum);
+  for (uint32_t i = 0; i < m_storage.size (); i++)
+    {
+      ifTraceFile >> m_storage[i];
+    }
+  m_samples = &m_storage[0];
+}
 
 
 TraceFadingLossModel::TraceFadingLossModel ()
@@ -48,9 +176,7 @@ TraceFadingLossModel::TraceFadingLossModel ()
 
 TraceFadingLossModel::~TraceFadingLossModel ()
 {
-  m_fadingTrace.clear ();
-  m_windowOffsetsMap.clear ();
-  m_startVariableMap.clear ();
+  NS_LOG_FUNCTION (this);
 }
 
 
@@ -115,35 +241,45 @@ TraceFadingLossModel::DoInitialize ()
   LoadTrace ();
 }
 
+void
+TraceFadingLossModel::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_fadingTrace = 0;
+  m_channelRealizations.clear ();
+  SpectrumPropagationLossModel::DoDispose ();
+}
+
 
 void
 TraceFadingLossModel::LoadTrace ()
 {
   NS_LOG_FUNCTION (this << "Loading Fading Trace " << m_traceFile);
-  std::ifstream ifTraceFile;
-  ifTraceFile.open (m_traceFile.c_str (), std::ifstream::in);
-  m_fadingTrace.clear ();
-  if (!ifTraceFile.good ())
-    {
-      NS_LOG_INFO (this << " File: " << m_traceFile);
-      NS_ASSERT_MSG(ifTraceFile.good (), " Fading trace file not found");
-    }
+  m_fadingTrace = FadingTrace::Get (m_traceFile, m_rbNum, m_samplesNum);
+  m_timeGranularity = m_traceLength.GetMilliSeconds () / m_samplesNum;
+  m_lastWindowUpdate = Simulator::Now ();
+}
 
-//   NS_LOG_INFO (this << " length " << m_traceLength.GetSeconds ());
-//   NS_LOG_INFO (this << " RB " << (uint32_t)m_rbNum << " samples " << m_samplesNum);
-  for (uint32_t i = 0; i < m_rbNum; i++)
+void
+TraceFadingLossModel::ConvertTrace (std::string asciiFileName, std::string binaryFileName,
+                                    uint8_t rbNum, uint32_t samplesNum)
+{
+  Ptr<const FadingTrace> trace = FadingTrace::Get (asciiFileName, rbNum, samplesNum);
+  std::ofstream os (binaryFileName.c_str (), std::ofstream::binary | std::ofstream::trunc);
+  NS_ABORT_MSG_UNLESS (os.good (), "Cannot write the fading trace " << binaryFileName);
+  uint32_t rbs = rbNum;
+  os.write (FADING_TRACE_MAGIC, sizeof (FADING_TRACE_MAGIC));
+  os.write (reinterpret_cast<const char *> (&rbs), sizeof (rbs));
+  os.write (reinterpret_cast<const char *> (&samplesNum), sizeof (samplesNum));
+  for (uint32_t i = 0; i < rbNum; i++)
     {
-      FadingTraceSample rbTimeFadingTrace;
-      for (uint32_t j = 0; j < m_samplesNum; j++)
+      for (uint32_t j = 0; j < samplesNum; j++)
         {
-          double sample;
-          ifTraceFile >> sample;
-          rbTimeFadingTrace.push_back (sample);
+          double sample = trace->GetValue (i, j);
+          os.write (reinterpret_cast<const char *> (&sample), sizeof (sample));
         }
-      m_fadingTrace.push_back (rbTimeFadingTrace);
     }
-  m_timeGranularity = m_traceLength.GetMilliSeconds () / m_samplesNum;
-  m_lastWindowUpdate = Simulator::Now ();
+  NS_ABORT_MSG_UNLESS (os.good (), "Cannot write the fading trace " << binaryFileName);
 }
 
 
@@ -155,28 +291,26 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity (
 {
   NS_LOG_FUNCTION (this << *txPsd << a << b);
   
-  std::map <ChannelRealizationId_t, int >::iterator itOff;
+  std::map <ChannelRealizationId_t, ChannelRealization>::iterator itOff;
   ChannelRealizationId_t mobilityPair = std::make_pair (a,b);
-  itOff = m_windowOffsetsMap.find (mobilityPair);
-  if (itOff!=m_windowOffsetsMap.end ())
+  itOff = m_channelRealizations.find (mobilityPair);
+  if (itOff!=m_channelRealizations.end ())
     {
       if (Simulator::Now ().GetSeconds () >= m_lastWindowUpdate.GetSeconds () + m_windowSize.GetSeconds ())
         {
           // update all the offsets
           NS_LOG_INFO ("Fading Windows Updated");
-          std::map <ChannelRealizationId_t, int >::iterator itOff2;
-          for (itOff2 = m_windowOffsetsMap.begin (); itOff2 != m_windowOffsetsMap.end (); itOff2++)
+          std::map <ChannelRealizationId_t, ChannelRealization>::iterator itOff2;
+          for (itOff2 = m_channelRealizations.begin (); itOff2 != m_channelRealizations.end (); itOff2++)
             {
-              std::map <ChannelRealizationId_t, Ptr<UniformRandomVariable> >::iterator itVar;
-              itVar = m_startVariableMap.find ((*itOff2).first);
-              (*itOff2).second = (*itVar).second->GetValue ();
+              (*itOff2).second.windowOffset = (*itOff2).second.startVariable->GetValue ();
             }
           m_lastWindowUpdate = Simulator::Now ();
         }
     }
   else
     {
-      NS_LOG_LOGIC (this << "insert new channel realization, m_windowOffsetMap.size () = " << m_windowOffsetsMap.size ());
+      NS_LOG_LOGIC (this << "insert new channel realization, m_channelRealizations.size () = " << m_channelRealizations.size ());
       Ptr<UniformRandomVariable> startV = CreateObject<UniformRandomVariable> ();
       startV->SetAttribute ("Min", DoubleValue (1.0));
       startV->SetAttribute ("Max", DoubleValue ((m_traceLength.GetSeconds () - m_windowSize.GetSeconds ()) * 1000.0));
@@ -186,9 +320,10 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity (
           startV->SetStream (m_currentStream);
           m_currentStream += 1;
         }
-      ChannelRealizationId_t mobilityPair = std::make_pair (a,b);
-      m_startVariableMap.insert (std::pair<ChannelRealizationId_t,Ptr<UniformRandomVariable> > (mobilityPair, startV));
-      m_windowOffsetsMap.insert (std::pair<ChannelRealizationId_t,int> (mobilityPair, startV->GetValue ()));
+      ChannelRealization realization;
+      realization.startVariable = startV;
+      realization.windowOffset = startV->GetValue ();
+      itOff = m_channelRealizations.insert (std::make_pair (mobilityPair, realization)).first;
     }
 
   
@@ -201,18 +336,18 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity (
   //double speed = std::sqrt (std::pow (aSpeedVector.x-bSpeedVector.x,2) + std::pow (aSpeedVector.y-bSpeedVector.y,2));
 
   NS_LOG_LOGIC (this << *rxPsd);
-  NS_ASSERT (!m_fadingTrace.empty ());
+  NS_ASSERT (m_fadingTrace != 0);
   int now_ms = static_cast<int> (Simulator::Now ().GetMilliSeconds () * m_timeGranularity);
   int lastUpdate_ms = static_cast<int> (m_lastWindowUpdate.GetMilliSeconds () * m_timeGranularity);
-  int index = ((*itOff).second + now_ms - lastUpdate_ms) % m_samplesNum;
+  int index = ((*itOff).second.windowOffset + now_ms - lastUpdate_ms) % m_samplesNum;
   int subChannel = 0;
   while (vit != rxPsd->ValuesEnd ())
     {
       NS_ASSERT (subChannel < 100);
       if (*vit != 0.)
         {
-          double fading = m_fadingTrace.at (subChannel).at (index);
-          NS_LOG_INFO (this << " FADING now " << now_ms << " offset " << (*itOff).second << " id " << index << " fading " << fading);
+          double fading = m_fadingTrace->GetValue (subChannel, index);
+          NS_LOG_INFO (this << " FADING now " << now_ms << " offset " << (*itOff).second.windowOffset << " id " << index << " fading " << fading);
           double power = *vit; // in Watt/Hz
           power = 10 * std::log10 (180000 * power); // in dB
 
@@ -241,15 +376,16 @@ TraceFadingLossModel::AssignStreams (int64_t stream)
   m_streamsAssigned = true;
   m_currentStream = stream;
   m_lastStream = stream + m_streamSetSize - 1;
-  std::map <ChannelRealizationId_t, Ptr<UniformRandomVariable> >::iterator itVar;
-  itVar = m_startVariableMap.begin ();
+  std::map <ChannelRealizationId_t, ChannelRealization>::iterator itVar;
+  itVar = m_channelRealizations.begin ();
   // the following loop is for eventually pre-existing ChannelRealization instances
   // note that more instances are expected to be created at run time
-  while (itVar!=m_startVariableMap.end ())
+  while (itVar!=m_channelRealizations.end ())
     {
       NS_ASSERT_MSG (m_currentStream <= m_lastStream, "not enough streams, consider increasing the StreamSetSize attribute");
-      (*itVar).second->SetStream (m_currentStream);
+      (*itVar).second.startVariable->SetStream (m_currentStream);
       m_currentStream += 1;
+      itVar++;
     }
   return m_streamSetSize;
 }
@@ -25,8 +25,11 @@
 
 
 #include <ns3/object.h>
+#include <ns3/assert.h>
+#include <ns3/simple-ref-count.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <map>
+#include <vector>
 #include "ns3/random-variable-stream.h"
 #include <ns3/nstime.h>
 
@@ -36,6 +39,71 @@ namespace ns3 {
 class MobilityModel;
 
 
+/**
+ * \ingroup lte
+ *
+ * \brief the samples of a fading trace file, loaded once and shared by all
+ * the TraceFadingLossModel instances which use the same file.
+ *
+ * The file is either in the ASCII format produced by the fading trace
+ * generator (one row per RB), or in the binary format written by
+ * TraceFadingLossModel::ConvertTrace, which is memory-mapped read-only
+ * where mmap is available.
+ */
+class FadingTrace : public SimpleRefCount<FadingTrace>
+{
+public:
+  ~FadingTrace ();
+
+  /**
+   * \brief Get the trace loaded from a file, loading it if needed
+   * \param fileName the name of the trace file
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB
+   * \return the trace
+   */
+  static Ptr<const FadingTrace> Get (std::string fileName, uint8_t rbNum, uint32_t samplesNum);
+
+  /**
+   * \param rb the RB
+   * \param sample the sample index
+   * \return the fading (dB) of the RB at the sample
+   */
+  double GetValue (uint32_t rb, uint32_t sample) const
+  {
+    NS_ASSERT (rb < m_rbNum && sample < m_samplesNum);
+    return m_samples[rb * m_samplesNum + sample];
+  }
+
+private:
+  /**
+   * \param key the key of the trace in the list of loaded traces
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB
+   */
+  FadingTrace (std::string key, uint8_t rbNum, uint32_t samplesNum);
+  /**
+   * \brief Map or read a trace file in the binary format
+   * \param fileName the name of the trace file
+   * \return false if the file is not in the binary format
+   */
+  bool LoadBinary (std::string fileName);
+  /**
+   * \brief Read a trace file in the ASCII format
+   * \param fileName the name of the trace file
+   */
+  void LoadAscii (std::string fileName);
+
+  std::string m_key;              ///< key in the list of loaded traces
+  uint8_t m_rbNum;                ///< number of RBs
+  uint32_t m_samplesNum;          ///< number of samples per RB
+  const double *m_samples;        ///< the samples, RB after RB
+  std::vector<double> m_storage;  ///< the samples, when they are not mapped
+  void *m_mapping;                ///< the mapped file, if any
+  size_t m_mappingSize;           ///< the size of the mapped file
+};
+
+
 /**
  * \ingroup lte
  *
@@ -50,6 +118,7 @@ public:
   static TypeId GetTypeId ();
   
   virtual void DoInitialize (void);
+  virtual void DoDispose (void);
 
   /**
    * \brief The couple of mobility mnode that form a fading channel realization
@@ -66,7 +135,20 @@ public:
   */
   int64_t AssignStreams (int64_t stream);
 
-  
+  /**
+   * \brief Convert a fading trace from the ASCII to the binary format
+   *
+   * Traces in the binary format are loaded without parsing, and shared
+   * through a read-only memory mapping where available.
+   *
+   * \param asciiFileName the name of the ASCII trace file
+   * \param binaryFileName the name of the binary trace file to write
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB
+   */
+  static void ConvertTrace (std::string asciiFileName, std::string binaryFileName,
+                            uint8_t rbNum, uint32_t samplesNum);
+
 private:
   /**
    * \param txPsd set of values vs frequency representing the
@@ -94,27 +176,23 @@ private:
   void LoadTrace ();
 
 
-   
-  mutable std::map <ChannelRealizationId_t, int > m_windowOffsetsMap;
-  
-  mutable std::map <ChannelRealizationId_t, Ptr<UniformRandomVariable> > m_startVariableMap;
-  
-  /**
-   * Vector with fading samples in time domain (for a fixed RB)
-   */
-  typedef std::vector<double> FadingTraceSample;
   /**
-   * Vector collecting the time fading traces in the frequency domain (per RB)
+   * \brief The window of a channel realization in the trace
    */
-  typedef std::vector<FadingTraceSample> FadingTrace;
+  struct ChannelRealization
+  {
+    int windowOffset;                    ///< start of the window (ms)
+    Ptr<UniformRandomVariable> startVariable; ///< draws the window start
+  };
 
+  /// the channel realizations
+  mutable std::map <ChannelRealizationId_t, ChannelRealization> m_channelRealizations;
 
-  
   std::string m_traceFile;
-  
-  FadingTrace m_fadingTrace;
 
-  
+  /// the fading samples, shared with the other models using the same file
+  Ptr<const FadingTrace> m_fadingTrace;
+
   Time m_traceLength;
   uint32_t m_samplesNum;
   Time m_windowSize;
@@ -0,0 +1,116 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <fstream>
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/trace-fading-loss-model.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteFadingTraceTest");
+
+/**
+ * \ingroup lte
+ *
+ * Check that a fading trace converted to the binary format holds the same
+ * samples as the ASCII trace, and that the loaded traces are shared.
+ */
+class LteFadingTraceTestCase : public TestCase
+{
+public:
+  LteFadingTraceTestCase ();
+  virtual ~LteFadingTraceTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \param rb the RB
+   * \param sample the sample index
+   * \return the value written in the test trace
+   */
+  static double GetSample (uint32_t rb, uint32_t sample);
+};
+
+LteFadingTraceTestCase::LteFadingTraceTestCase ()
+  : TestCase ("Binary and shared fading traces")
+{
+}
+
+LteFadingTraceTestCase::~LteFadingTraceTestCase ()
+{
+}
+
+double
+LteFadingTraceTestCase::GetSample (uint32_t rb, uint32_t sample)
+{
+  return -0.25 * rb + 0.125 * sample - 7.5;
+}
+
+void
+LteFadingTraceTestCase::DoRun (void)
+{
+  const uint8_t rbNum = 6;
+  const uint32_t samplesNum = 40;
+  std::string asciiFile = CreateTempDirFilename ("fading-trace.fad");
+  std::string binaryFile = CreateTempDirFilename ("fading-trace.bin");
+  {
+    std::ofstream os (asciiFile.c_str ());
+    for (uint32_t i = 0; i < rbNum; i++)
+      {
+        for (uint32_t j = 0; j < samplesNum; j++)
+          {
+            os << GetSample (i, j) << " ";
+          }
+        os << "\n";
+      }
+  }
+  TraceFadingLossModel::ConvertTrace (asciiFile, binaryFile, rbNum, samplesNum);
+
+  Ptr<const FadingTrace> ascii = FadingTrace::Get (asciiFile, rbNum, samplesNum);
+  Ptr<const FadingTrace> binary = FadingTrace::Get (binaryFile, rbNum, samplesNum);
+  NS_TEST_ASSERT_MSG_EQ (FadingTrace::Get (binaryFile, rbNum, samplesNum), binary,
+                         "The trace is loaded twice");
+  NS_TEST_ASSERT_MSG_NE (ascii, binary, "Different files share a trace");
+  for (uint32_t i = 0; i < rbNum; i++)
+    {
+      for (uint32_t j = 0; j < samplesNum; j++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (ascii->GetValue (i, j), GetSample (i, j), "Wrong ASCII sample");
+          NS_TEST_ASSERT_MSG_EQ (binary->GetValue (i, j), GetSample (i, j), "Wrong binary sample");
+        }
+    }
+}
+
+
+/**
+ * \ingroup lte
+ *
+ * Test suite for the fading traces.
+ */
+class LteFadingTraceTestSuite : public TestSuite
+{
+public:
+  LteFadingTraceTestSuite ();
+};
+
+LteFadingTraceTestSuite::LteFadingTraceTestSuite ()
+  : TestSuite ("lte-fading-trace", UNIT)
+{
+  AddTestCase (new LteFadingTraceTestCase, TestCase::QUICK);
+}
+
+static LteFadingTraceTestSuite lteFadingTraceTestSuite;
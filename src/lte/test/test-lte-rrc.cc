@@ -85,6 +85,7 @@ protected:
   uint32_t m_delayDiscEnd; // expected duration to complete disconnection in ms
   bool     m_useIdealRrc; // If set to false, real RRC protocol model will be used
   bool     m_admitRrcConnectionRequest; // If set to false, eNb will not allow UE connections
+  bool     m_passDecodedRrcMessages; // If set to true, the real RRC protocol passes the messages without encoding them
   Ptr<LteHelper> m_lteHelper;
 
   // key: IMSI
@@ -152,7 +153,8 @@ LteRrcConnectionEstablishmentTestCase::LteRrcConnectionEstablishmentTestCase (
     m_delayDiscStart (delayDiscStart),
     m_delayDiscEnd (10),
     m_useIdealRrc (useIdealRrc),
-    m_admitRrcConnectionRequest (admitRrcConnectionRequest)
+    m_admitRrcConnectionRequest (admitRrcConnectionRequest),
+    m_passDecodedRrcMessages (false)
 {
   NS_LOG_FUNCTION (this << GetName ());
 
@@ -229,6 +231,8 @@ LteRrcConnectionEstablishmentTestCase::DoRun ()
     {
       Config::SetDefault ("ns3::LteEnbRrc::SrsPeriodicity", UintegerValue (320));
     }
+  Config::SetDefault ("ns3::LteUeRrcProtocolReal::PassDecodedMessages", BooleanValue (m_passDecodedRrcMessages));
+  Config::SetDefault ("ns3::LteEnbRrcProtocolReal::PassDecodedMessages", BooleanValue (m_passDecodedRrcMessages));
 
   // normal code
   m_lteHelper = CreateObject<LteHelper> ();
@@ -493,6 +497,32 @@ LteRrcConnectionEstablishmentTestCase::ConnectionTimeoutCallback (
 
 
 
+/**
+ * Connection establishment with the real RRC protocol, passing the
+ * decoded RRC messages instead of encoding them.
+ */
+class LteRrcPassDecodedMessagesTestCase
+  : public LteRrcConnectionEstablishmentTestCase
+{
+public:
+  /**
+   * \param nUes number of UEs in the test
+   * \param nBearers number of bearers to be setup in each connection
+   */
+  LteRrcPassDecodedMessagesTestCase (uint32_t nUes, uint32_t nBearers);
+};
+
+
+LteRrcPassDecodedMessagesTestCase::LteRrcPassDecodedMessagesTestCase (
+  uint32_t nUes, uint32_t nBearers)
+  : LteRrcConnectionEstablishmentTestCase (nUes, nBearers, 20, 10, 1, false, false, true,
+                                           "decoded messages passed")
+{
+  m_passDecodedRrcMessages = true;
+}
+
+
+
 class LteRrcConnectionEstablishmentErrorTestCase
   : public LteRrcConnectionEstablishmentTestCase
 {
@@ -727,6 +757,9 @@ LteRrcTestSuite::LteRrcTestSuite ()
       AddTestCase (new LteRrcConnectionEstablishmentTestCase (  3,     0,     20,           0,           1, false, useIdealRrc, false), TestCase::EXTENSIVE);
     }
 
+  // Test case with the real RRC protocol passing the decoded messages
+  AddTestCase (new LteRrcPassDecodedMessagesTestCase (2, 2), TestCase::QUICK);
+
   // Test cases with transmission error
   AddTestCase (new LteRrcConnectionEstablishmentErrorTestCase (
                    Seconds (0.020214),
@@ -48,6 +48,15 @@ ConstantAccelerationMobilityModel::DoGetVelocity (void) const
                  m_baseVelocity.z + m_acceleration.z*t);
 }
 
+bool
+ConstantAccelerationMobilityModel::DoIsStationary (void) const
+{
+  // a null velocity does not mean that it is not going to move
+  Vector velocity = DoGetVelocity ();
+  return velocity.x == 0 && velocity.y == 0 && velocity.z == 0
+         && m_acceleration.x == 0 && m_acceleration.y == 0 && m_acceleration.z == 0;
+}
+
 inline Vector
 ConstantAccelerationMobilityModel::DoGetPosition (void) const
 {
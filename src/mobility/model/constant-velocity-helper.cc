@@ -34,6 +34,7 @@ ConstantVelocityHelper::ConstantVelocityHelper ()
 }
 ConstantVelocityHelper::ConstantVelocityHelper (const Vector &position)
   : m_position (position),
+    m_legPosition (position),
     m_paused (true)
 {
   NS_LOG_FUNCTION (this << position);
@@ -41,6 +42,7 @@ ConstantVelocityHelper::ConstantVelocityHelper (const Vector &position)
 ConstantVelocityHelper::ConstantVelocityHelper (const Vector &position,
                                                 const Vector &vel)
   : m_position (position),
+    m_legPosition (position),
     m_velocity (vel),
     m_paused (true)
 {
@@ -53,6 +55,8 @@ ConstantVelocityHelper::SetPosition (const Vector &position)
   m_position = position;
   m_velocity = Vector (0.0, 0.0, 0.0);
   m_lastUpdate = Simulator::Now ();
+  m_legPosition = m_position;
+  m_legStart = m_lastUpdate;
 }
 
 Vector
@@ -74,6 +78,8 @@ ConstantVelocityHelper::SetVelocity (const Vector &vel)
   NS_LOG_FUNCTION (this << vel);
   m_velocity = vel;
   m_lastUpdate = Simulator::Now ();
+  m_legPosition = m_position;
+  m_legStart = m_lastUpdate;
 }
 
 void
@@ -82,16 +88,19 @@ ConstantVelocityHelper::Update (void) const
   NS_LOG_FUNCTION (this);
   Time now = Simulator::Now ();
   NS_ASSERT (m_lastUpdate <= now);
-  Time deltaTime = now - m_lastUpdate;
+  if (now == m_lastUpdate)
+    {
+      return;
+    }
   m_lastUpdate = now;
   if (m_paused)
     {
       return;
     }
-  double deltaS = deltaTime.GetSeconds ();
-  m_position.x += m_velocity.x * deltaS;
-  m_position.y += m_velocity.y * deltaS;
-  m_position.z += m_velocity.z * deltaS;
+  double deltaS = (now - m_legStart).GetSeconds ();
+  m_position.x = m_legPosition.x + m_velocity.x * deltaS;
+  m_position.y = m_legPosition.y + m_velocity.y * deltaS;
+  m_position.z = m_legPosition.z + m_velocity.z * deltaS;
 }
 
 void
@@ -99,10 +108,17 @@ ConstantVelocityHelper::UpdateWithBounds (const Rectangle &bounds) const
 {
   NS_LOG_FUNCTION (this << bounds);
   Update ();
+  Vector position = m_position;
   m_position.x = std::min (bounds.xMax, m_position.x);
   m_position.x = std::max (bounds.xMin, m_position.x);
   m_position.y = std::min (bounds.yMax, m_position.y);
   m_position.y = std::max (bounds.yMin, m_position.y);
+  if (m_position.x != position.x || m_position.y != position.y)
+    {
+      // the current leg now starts from the bound
+      m_legPosition = m_position;
+      m_legStart = m_lastUpdate;
+    }
 }
 
 void
@@ -110,12 +126,19 @@ ConstantVelocityHelper::UpdateWithBounds (const Box &bounds) const
 {
   NS_LOG_FUNCTION (this << bounds);
   Update ();
+  Vector position = m_position;
   m_position.x = std::min (bounds.xMax, m_position.x);
   m_position.x = std::max (bounds.xMin, m_position.x);
   m_position.y = std::min (bounds.yMax, m_position.y);
   m_position.y = std::max (bounds.yMin, m_position.y);
   m_position.z = std::min (bounds.zMax, m_position.z);
   m_position.z = std::max (bounds.zMin, m_position.z);
+  if (m_position.x != position.x || m_position.y != position.y || m_position.z != position.z)
+    {
+      // the current leg now starts from the bound
+      m_legPosition = m_position;
+      m_legStart = m_lastUpdate;
+    }
 }
 
 void 
@@ -130,6 +153,9 @@ ConstantVelocityHelper::Unpause (void)
 {
   NS_LOG_FUNCTION (this);
   m_paused = false;
+  // resume from the last computed position
+  m_legPosition = m_position;
+  m_legStart = m_lastUpdate;
 }
 
 } // namespace ns3
@@ -32,6 +32,12 @@ class Rectangle;
  * \ingroup mobility
  *
  * \brief Utility class used to move node with constant velocity.
+ *
+ * The position is computed in closed form from the position and time at
+ * which the current leg started (set by SetPosition, SetVelocity, Unpause
+ * and the bounds), rather than accumulated from one update to the next:
+ * it does not drift however often it is updated, and updating it several
+ * times at the same simulation time costs a single computation.
  */
 class ConstantVelocityHelper
 {
@@ -96,6 +102,8 @@ public:
 private:
   mutable Time m_lastUpdate; //!< time of last update
   mutable Vector m_position; //!< state variable for current position
+  mutable Vector m_legPosition; //!< position at the start of the current leg
+  mutable Time m_legStart; //!< time of the start of the current leg
   Vector m_velocity; //!< state variable for velocity
   bool m_paused;  //!< state variable for paused
 };
@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <algorithm>
+#include <cmath>
+#include "mobility-grid-index.h"
+#include "ns3/callback.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MobilityGridIndex");
+
+MobilityGridIndex::MobilityGridIndex ()
+  : m_cellSize (100.0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MobilityGridIndex::~MobilityGridIndex ()
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+}
+
+void
+MobilityGridIndex::SetCellSize (double size)
+{
+  NS_LOG_FUNCTION (this << size);
+  NS_ASSERT (size > 0);
+  Clear ();
+  m_cellSize = size;
+}
+
+void
+MobilityGridIndex::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::map<const MobilityModel *, std::vector<uint32_t> >::iterator it = m_models.begin ();
+       it != m_models.end (); ++it)
+    {
+      Ptr<MobilityModel> mobility = m_entries[it->second.front ()].mobility;
+      mobility->TraceDisconnectWithoutContext ("CourseChange",
+                                               MakeCallback (&MobilityGridIndex::CourseChanged, this));
+    }
+  m_models.clear ();
+  m_entries.clear ();
+  m_cells.clear ();
+  m_unindexed.clear ();
+}
+
+uint32_t
+MobilityGridIndex::GetN (void) const
+{
+  return m_entries.size ();
+}
+
+int64_t
+MobilityGridIndex::GetCellCoordinate (double x) const
+{
+  return static_cast<int64_t> (std::floor (x / m_cellSize));
+}
+
+void
+MobilityGridIndex::Add (uint32_t id, Ptr<MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << id << mobility);
+  Entry entry;
+  entry.id = id;
+  entry.mobility = mobility;
+  entry.inGrid = false;
+  m_entries.push_back (entry);
+  uint32_t index = m_entries.size () - 1;
+  if (mobility != 0)
+    {
+      std::vector<uint32_t> &entries = m_models[PeekPointer (mobility)];
+      if (entries.empty ())
+        {
+          mobility->TraceConnectWithoutContext ("CourseChange",
+                                                MakeCallback (&MobilityGridIndex::CourseChanged, this));
+        }
+      entries.push_back (index);
+    }
+  Insert (index);
+}
+
+bool
+MobilityGridIndex::IsIndexable (Ptr<MobilityModel> mobility)
+{
+  return mobility != 0 && mobility->IsStationary ();
+}
+
+void
+MobilityGridIndex::Insert (uint32_t index)
+{
+  Entry &entry = m_entries[index];
+  entry.inGrid = IsIndexable (entry.mobility);
+  if (entry.inGrid)
+    {
+      Vector position = entry.mobility->GetPosition ();
+      entry.cell = CellKey (GetCellCoordinate (position.x), GetCellCoordinate (position.y));
+      m_cells[entry.cell].push_back (index);
+    }
+  else
+    {
+      m_unindexed.push_back (index);
+    }
+}
+
+void
+MobilityGridIndex::Remove (uint32_t index)
+{
+  Entry &entry = m_entries[index];
+  if (entry.inGrid)
+    {
+      std::map<CellKey, std::vector<uint32_t> >::iterator cell = m_cells.find (entry.cell);
+      NS_ASSERT (cell != m_cells.end ());
+      cell->second.erase (std::find (cell->second.begin (), cell->second.end (), index));
+      if (cell->second.empty ())
+        {
+          m_cells.erase (cell);
+        }
+    }
+  else
+    {
+      m_unindexed.erase (std::find (m_unindexed.begin (), m_unindexed.end (), index));
+    }
+}
+
+void
+MobilityGridIndex::CourseChanged (Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  std::map<const MobilityModel *, std::vector<uint32_t> >::const_iterator it = m_models.find (PeekPointer (mobility));
+  if (it == m_models.end ())
+    {
+      return;
+    }
+  for (std::vector<uint32_t>::const_iterator index = it->second.begin (); index != it->second.end (); ++index)
+    {
+      Remove (*index);
+      Insert (*index);
+    }
+}
+
+void
+MobilityGridIndex::GetInRange (const Vector &position, double range, std::vector<uint32_t> &ids) const
+{
+  NS_LOG_FUNCTION (this << position << range);
+  ids.clear ();
+  double range2 = range * range;
+
+  int64_t xMin = GetCellCoordinate (position.x - range);
+  int64_t xMax = GetCellCoordinate (position.x + range);
+  int64_t yMin = GetCellCoordinate (position.y - range);
+  int64_t yMax = GetCellCoordinate (position.y + range);
+
+  std::vector<const std::vector<uint32_t> *> cells;
+  if (static_cast<double> (xMax - xMin + 1) * (yMax - yMin + 1) <= m_cells.size ())
+    {
+      for (int64_t x = xMin; x <= xMax; x++)
+        {
+          for (int64_t y = yMin; y <= yMax; y++)
+            {
+              std::map<CellKey, std::vector<uint32_t> >::const_iterator cell = m_cells.find (CellKey (x, y));
+              if (cell != m_cells.end ())
+                {
+                  cells.push_back (&cell->second);
+                }
+            }
+        }
+    }
+  else
+    {
+      // the range covers more cells than are occupied
+      for (std::map<CellKey, std::vector<uint32_t> >::const_iterator cell = m_cells.begin ();
+           cell != m_cells.end (); ++cell)
+        {
+          if (cell->first.first >= xMin && cell->first.first <= xMax
+              && cell->first.second >= yMin && cell->first.second <= yMax)
+            {
+              cells.push_back (&cell->second);
+            }
+        }
+    }
+  cells.push_back (&m_unindexed);
+
+  for (std::vector<const std::vector<uint32_t> *>::const_iterator cell = cells.begin ();
+       cell != cells.end (); ++cell)
+    {
+      for (std::vector<uint32_t>::const_iterator index = (*cell)->begin (); index != (*cell)->end (); ++index)
+        {
+          const Entry &entry = m_entries[*index];
+          if (entry.mobility != 0)
+            {
+              Vector other = entry.mobility->GetPosition ();
+              double dx = other.x - position.x;
+              double dy = other.y - position.y;
+              double dz = other.z - position.z;
+              if (dx * dx + dy * dy + dz * dz > range2)
+                {
+                  continue;
+                }
+            }
+          ids.push_back (entry.id);
+        }
+    }
+  std::sort (ids.begin (), ids.end ());
+}
+
+} // namespace ns3
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef MOBILITY_GRID_INDEX_H
+#define MOBILITY_GRID_INDEX_H
+
+#include <map>
+#include <vector>
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+#include "mobility-model.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup mobility
+ * \brief a uniform grid of mobility models, to find the models close to
+ * a position without looking at all of them.
+ *
+ * Each model is identified by an integer chosen by the user (typically its
+ * index in a list of devices).  Models which are not moving are stored in
+ * the square cell of the xy plane which contains their position; the
+ * index follows their "CourseChange" trace source to move them to another
+ * cell or to the list of moving models, whose positions are always checked.
+ * The models of a constant acceleration, the models which do not notify
+ * all their course changes (attribute LazyNotify set to true, as in
+ * ns3::WaypointMobilityModel), and ids added without a mobility model,
+ * are also always checked.
+ *
+ * GetInRange returns exactly the ids whose current distance to a position
+ * is not larger than the range, whatever the cell size.
+ */
+class MobilityGridIndex
+{
+public:
+  MobilityGridIndex ();
+  ~MobilityGridIndex ();
+
+  /**
+   * \param size the side of the square cells, in meters.
+   *
+   * Removes all the models from the index.
+   */
+  void SetCellSize (double size);
+
+  /**
+   * \param id the identifier of the model.
+   * \param mobility the mobility model, or 0 if the id must always be
+   * returned by GetInRange.
+   */
+  void Add (uint32_t id, Ptr<MobilityModel> mobility);
+
+  /**
+   * Removes all the models from the index.
+   */
+  void Clear (void);
+
+  /**
+   * \return the number of ids in the index.
+   */
+  uint32_t GetN (void) const;
+
+  /**
+   * \param position the center of the search.
+   * \param range the search radius, in meters.
+   * \param ids the ids of the models within range, in increasing order.
+   */
+  void GetInRange (const Vector &position, double range, std::vector<uint32_t> &ids) const;
+
+private:
+  /// The coordinates of a cell.
+  typedef std::pair<int64_t, int64_t> CellKey;
+
+  /// An id in the index.
+  struct Entry
+  {
+    uint32_t id;                  //!< The user identifier.
+    Ptr<MobilityModel> mobility;  //!< Its mobility model, if any.
+    bool inGrid;                  //!< True if stored in a cell.
+    CellKey cell;                 //!< The cell, if stored in one.
+  };
+
+  /**
+   * \param x a coordinate.
+   * \return the cell coordinate.
+   */
+  int64_t GetCellCoordinate (double x) const;
+
+  /**
+   * Store an entry in a cell or in the list of moving entries.
+   * \param index the entry index in m_entries.
+   */
+  void Insert (uint32_t index);
+
+  /**
+   * Remove an entry from its cell or from the list of moving entries.
+   * \param index the entry index in m_entries.
+   */
+  void Remove (uint32_t index);
+
+  /**
+   * \param mobility a mobility model.
+   * \return true if the model can be stored in a cell.
+   */
+  static bool IsIndexable (Ptr<MobilityModel> mobility);
+
+  /**
+   * Trace sink for the CourseChange trace source of the models.
+   * \param mobility the model whose course changed.
+   */
+  void CourseChanged (Ptr<const MobilityModel> mobility);
+
+  /**
+   * Copying the index would leave the trace sinks pointing to the original.
+   * \param o the index.
+   */
+  MobilityGridIndex (const MobilityGridIndex &o);
+  /**
+   * Copying the index would leave the trace sinks pointing to the original.
+   * \param o the index.
+   * \return the index.
+   */
+  MobilityGridIndex &operator = (const MobilityGridIndex &o);
+
+  double m_cellSize;                                 //!< Side of the cells.
+  std::vector<Entry> m_entries;                      //!< All the entries.
+  std::map<CellKey, std::vector<uint32_t> > m_cells; //!< Entries of the non-empty cells.
+  std::vector<uint32_t> m_unindexed;                 //!< Entries not in a cell.
+  /// Entries of each model, as a model can be shared by several ids.
+  std::map<const MobilityModel *, std::vector<uint32_t> > m_models;
+};
+
+} // namespace ns3
+
+#endif /* MOBILITY_GRID_INDEX_H */
@@ -94,6 +94,19 @@ MobilityModel::GetRelativeSpeed (Ptr<const MobilityModel> other) const
   return sqrt( (x*x) + (y*y) + (z*z) );
 }
 
+bool
+MobilityModel::IsStationary (void) const
+{
+  return DoIsStationary ();
+}
+
+bool
+MobilityModel::DoIsStationary (void) const
+{
+  Vector velocity = DoGetVelocity ();
+  return velocity.x == 0 && velocity.y == 0 && velocity.z == 0;
+}
+
 void
 MobilityModel::NotifyCourseChange (void) const
 {
@@ -69,6 +69,11 @@ public:
    * \return the relative speed between the two objects. Unit is meters/s.
    */
   double GetRelativeSpeed (Ptr<const MobilityModel> other) const;
+  /**
+   * \return true if the object does not move until the model notifies
+   * a course change, false if it may move without notifying it.
+   */
+  bool IsStationary (void) const;
   /**
    * Assign a fixed random variable stream number to the random variables
    * used by this model. Return the number of streams (possibly zero) that
@@ -122,6 +127,14 @@ private:
    * \return the number of streams used
    */
   virtual int64_t DoAssignStreams (int64_t start);
+  /**
+   * The default implementation returns true if the current velocity
+   * is null.  Subclasses which may start moving without notifying a
+   * course change are expected to override this.
+   * \return true if the object does not move until the model
+   * notifies a course change.
+   */
+  virtual bool DoIsStationary (void) const;
 
   /**
    * Used to alert subscribers that a change in direction, velocity,
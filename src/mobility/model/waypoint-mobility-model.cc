@@ -213,5 +213,13 @@ WaypointMobilityModel::DoGetVelocity (void) const
   return m_velocity;
 }
 
+bool
+WaypointMobilityModel::DoIsStationary (void) const
+{
+  // a lazy model may start moving without a course change
+  return !m_lazyNotify
+         && m_velocity.x == 0 && m_velocity.y == 0 && m_velocity.z == 0;
+}
+
 } // namespace ns3
 
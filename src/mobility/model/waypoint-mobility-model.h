@@ -156,6 +156,12 @@ private:
    * \return The velocity vector of a node. 
    */
   virtual Vector DoGetVelocity (void) const;
+  /**
+   * \brief Tells whether the node stays where it is until the next
+   * course change, which is never the case with LazyNotify
+   * \return true if the node is paused and notifies its course changes
+   */
+  virtual bool DoIsStationary (void) const;
 
   /**
    * \brief This variable is set to true if there are no waypoints in the std::deque
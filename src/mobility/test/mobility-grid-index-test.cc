@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/simulator.h"
+#include "ns3/mobility-grid-index.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/waypoint-mobility-model.h"
+#include "ns3/boolean.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * Check that the grid index returns the same ids as an exhaustive search,
+ * while models are moved, start and stop moving.
+ */
+class MobilityGridIndexTest : public TestCase
+{
+public:
+  MobilityGridIndexTest ()
+    : TestCase ("Check the ids returned by the mobility grid index")
+  {
+  }
+  virtual ~MobilityGridIndexTest ()
+  {
+  }
+
+private:
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+  /**
+   * Compare the index with an exhaustive search.
+   * \param position the center of the search.
+   * \param range the search radius.
+   */
+  void Check (Vector position, double range);
+
+  std::vector<Ptr<MobilityModel> > m_models; //!< model of each id
+  MobilityGridIndex m_index;                 //!< the index under test
+};
+
+void
+MobilityGridIndexTest::DoTeardown (void)
+{
+  m_index.Clear ();
+  m_models.clear ();
+}
+
+void
+MobilityGridIndexTest::Check (Vector position, double range)
+{
+  std::vector<uint32_t> expected;
+  for (uint32_t i = 0; i < m_models.size (); i++)
+    {
+      if (CalculateDistance (m_models[i]->GetPosition (), position) <= range)
+        {
+          expected.push_back (i);
+        }
+    }
+  std::vector<uint32_t> ids;
+  m_index.GetInRange (position, range, ids);
+  NS_TEST_ASSERT_MSG_EQ (ids.size (), expected.size (),
+                         "Wrong number of ids around " << position << " at " << Simulator::Now ().GetSeconds ());
+  for (uint32_t i = 0; i < ids.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (ids[i], expected[i], "Wrong id around " << position);
+    }
+}
+
+void
+MobilityGridIndexTest::DoRun (void)
+{
+  m_index.SetCellSize (50);
+  for (uint32_t i = 0; i < 400; i++)
+    {
+      Ptr<MobilityModel> model = CreateObject<ConstantPositionMobilityModel> ();
+      model->SetPosition (Vector ((i % 20) * 17.0 - 100, (i / 20) * 23.0 - 50, i % 3));
+      m_models.push_back (model);
+    }
+  Ptr<ConstantVelocityMobilityModel> mover = CreateObject<ConstantVelocityMobilityModel> ();
+  mover->SetPosition (Vector (0, 0, 0));
+  m_models.push_back (mover);
+  // paused at its first waypoint when indexed, then moving without any
+  // course change
+  Ptr<WaypointMobilityModel> lazy = CreateObjectWithAttributes<WaypointMobilityModel> ("LazyNotify", BooleanValue (true));
+  lazy->AddWaypoint (Waypoint (Seconds (0), Vector (-300, -300, 0)));
+  lazy->AddWaypoint (Waypoint (Seconds (5), Vector (-300, -300, 0)));
+  lazy->AddWaypoint (Waypoint (Seconds (15), Vector (-200, -300, 0)));
+  m_models.push_back (lazy);
+  for (uint32_t i = 0; i < m_models.size (); i++)
+    {
+      m_index.Add (i, m_models[i]);
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_index.GetN (), 402, "Wrong number of ids");
+
+  Check (Vector (0, 0, 0), 50);
+  Check (Vector (30, 70, 0), 120);
+  Check (Vector (-100, -50, 0), 10);
+  Check (Vector (0, 0, 0), 1e6);
+
+  // moved static models go to their new cell
+  m_models[0]->SetPosition (Vector (500, 500, 0));
+  m_models[1]->SetPosition (Vector (-123, 210, 1));
+  Check (Vector (500, 500, 0), 1);
+  Check (Vector (-100, 200, 0), 60);
+
+  // a model moving with a constant velocity is tracked without course changes
+  mover->SetVelocity (Vector (10, 5, 0));
+  Simulator::Schedule (Seconds (10), &MobilityGridIndexTest::Check, this, Vector (100, 50, 0), 5);
+  Simulator::Schedule (Seconds (20), &MobilityGridIndexTest::Check, this, Vector (200, 100, 0), 5);
+  Simulator::Schedule (Seconds (21), &ConstantVelocityMobilityModel::SetVelocity, mover, Vector (0, 0, 0));
+  Simulator::Schedule (Seconds (30), &MobilityGridIndexTest::Check, this, Vector (210, 105, 0), 1);
+  // a lazily notifying model is found at its current position
+  Simulator::Schedule (Seconds (10), &MobilityGridIndexTest::Check, this, Vector (-250, -300, 0), 1);
+  Simulator::Schedule (Seconds (20), &MobilityGridIndexTest::Check, this, Vector (-200, -300, 0), 1);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+static struct MobilityGridIndexTestSuite : public TestSuite
+{
+  MobilityGridIndexTestSuite () : TestSuite ("mobility-grid-index", UNIT)
+  {
+    AddTestCase (new MobilityGridIndexTest (), TestCase::QUICK);
+  }
+} g_mobilityGridIndexTestSuite;
@@ -30,6 +30,7 @@
 #include "ns3/vector.h"
 #include "ns3/mobility-model.h"
 #include "ns3/waypoint-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/mobility-helper.h"
 
 using namespace ns3;
@@ -354,6 +355,54 @@ WaypointMobilityModelViaHelper::DoRun (void)
   Simulator::Destroy ();
 }
 
+// Test that the position of a node moving at constant velocity does not
+// drift however often it is updated
+class ConstantVelocityNoDrift : public TestCase
+{
+public:
+  ConstantVelocityNoDrift ();
+  virtual ~ConstantVelocityNoDrift ();
+
+private:
+  void GetPosition (void);
+  virtual void DoRun (void);
+  Ptr<ConstantVelocityMobilityModel> m_mob;
+};
+
+ConstantVelocityNoDrift::ConstantVelocityNoDrift ()
+  : TestCase ("Test that frequent updates of a constant velocity position do not drift")
+{
+}
+
+ConstantVelocityNoDrift::~ConstantVelocityNoDrift ()
+{
+}
+
+void
+ConstantVelocityNoDrift::GetPosition (void)
+{
+  m_mob->GetPosition ();
+  // twice at the same time
+  m_mob->GetPosition ();
+  Simulator::Schedule (MilliSeconds (1), &ConstantVelocityNoDrift::GetPosition, this);
+}
+
+void
+ConstantVelocityNoDrift::DoRun (void)
+{
+  m_mob = CreateObject<ConstantVelocityMobilityModel> ();
+  m_mob->SetPosition (Vector (1.0, 2.0, 3.0));
+  m_mob->SetVelocity (Vector (0.1, -0.3, 0.7));
+  Simulator::ScheduleNow (&ConstantVelocityNoDrift::GetPosition, this);
+  Simulator::Stop (Seconds (100.0));
+  Simulator::Run ();
+  Vector pos = m_mob->GetPosition ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (pos.x, 1.0 + 0.1 * 100.0, 1e-12, "Position drifted");
+  NS_TEST_EXPECT_MSG_EQ_TOL (pos.y, 2.0 - 0.3 * 100.0, 1e-12, "Position drifted");
+  NS_TEST_EXPECT_MSG_EQ_TOL (pos.z, 3.0 + 0.7 * 100.0, 1e-12, "Position drifted");
+  Simulator::Destroy ();
+}
+
 class MobilityTestSuite : public TestSuite
 {
 public:
@@ -367,6 +416,7 @@ MobilityTestSuite::MobilityTestSuite ()
   AddTestCase (new WaypointLazyNotifyTrue, TestCase::QUICK);
   AddTestCase (new WaypointInitialPositionIsWaypoint, TestCase::QUICK);
   AddTestCase (new WaypointMobilityModelViaHelper, TestCase::QUICK);
+  AddTestCase (new ConstantVelocityNoDrift, TestCase::QUICK);
 }
 
 static MobilityTestSuite mobilityTestSuite;
@@ -25,6 +25,7 @@
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/pcap-file.h"
+#include "ns3/packet.h"
 
 using namespace ns3;
 
@@ -1121,6 +1122,90 @@ DiffTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+// ===========================================================================
+// Test case to make sure that buffered writes produce the same file as
+// unbuffered writes, and that records are only written when the buffer is
+// drained.
+// ===========================================================================
+class BufferedWriteTestCase : public TestCase
+{
+public:
+  BufferedWriteTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Write the known packets, plus a Packet, to a file
+   * \param filename the file name
+   * \param bufferSize the write buffer size
+   */
+  void WriteFile (std::string filename, uint32_t bufferSize);
+};
+
+BufferedWriteTestCase::BufferedWriteTestCase ()
+  : TestCase ("Check that buffered writes produce the same pcap file")
+{
+}
+
+void
+BufferedWriteTestCase::WriteFile (std::string filename, uint32_t bufferSize)
+{
+  PcapFile f;
+  f.Open (filename, std::ios::out);
+  NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Open (" << filename << ", \"std::ios::out\") returns error");
+  f.SetWriteBufferSize (bufferSize);
+  f.Init (1, N_PACKET_BYTES);
+
+  for (uint32_t i = 0; i < N_KNOWN_PACKETS; ++i)
+    {
+      PacketEntry const & p = knownPackets[i];
+      f.Write (p.tsSec, p.tsUsec, (uint8_t const *)p.data, p.origLen);
+    }
+  f.Write (3, 0, Create<Packet> (100));
+  NS_TEST_EXPECT_MSG_EQ (f.Fail (), false, "Write must not fail");
+  f.Close ();
+}
+
+void
+BufferedWriteTestCase::DoRun (void)
+{
+  std::string unbuffered = CreateTempDirFilename ("unbuffered.pcap");
+  std::string buffered = CreateTempDirFilename ("buffered.pcap");
+  std::string small = CreateTempDirFilename ("small-buffer.pcap");
+
+  WriteFile (unbuffered, 0);
+  WriteFile (buffered, 1 << 16);
+  // buffer smaller than a record: forces a drain at every write
+  WriteFile (small, 20);
+
+  uint32_t sec (0), usec (0), packets (0);
+  bool diff = PcapFile::Diff (unbuffered, buffered, sec, usec, packets);
+  NS_TEST_EXPECT_MSG_EQ (diff, false, "Buffered file differs from unbuffered file");
+  NS_TEST_EXPECT_MSG_EQ (packets, N_KNOWN_PACKETS + 1, "Wrong number of packets");
+  diff = PcapFile::Diff (unbuffered, small, sec, usec, packets);
+  NS_TEST_EXPECT_MSG_EQ (diff, false, "Small-buffer file differs from unbuffered file");
+
+  // 24 bytes of file header, 7 records of 16 bytes of header and 16 of data
+  uint64_t expected = 24 + (N_KNOWN_PACKETS + 1) * (16 + N_PACKET_BYTES);
+  NS_TEST_EXPECT_MSG_EQ (CheckFileLength (buffered, expected), true, "Unexpected buffered file size");
+
+  //
+  // While the buffer is not full, only the file header reaches the file
+  //
+  PcapFile f;
+  f.Open (buffered, std::ios::out);
+  f.SetWriteBufferSize (1 << 16);
+  f.Init (1, N_PACKET_BYTES);
+  f.Write (1, 0, Create<Packet> (10));
+  f.Flush ();
+  NS_TEST_EXPECT_MSG_EQ (CheckFileLength (buffered, 24 + 16 + 10), true, "Flush did not write the record");
+  f.Write (2, 0, Create<Packet> (10));
+  NS_TEST_EXPECT_MSG_EQ (CheckFileLength (buffered, 24 + 16 + 10), true, "Record written before the buffer was drained");
+  f.Close ();
+  NS_TEST_EXPECT_MSG_EQ (CheckFileLength (buffered, 24 + 2 * (16 + 10)), true, "Close did not drain the buffer");
+}
+
 class PcapFileTestSuite : public TestSuite
 {
 public:
@@ -1138,6 +1223,7 @@ PcapFileTestSuite::PcapFileTestSuite ()
   AddTestCase (new RecordHeaderTestCase, TestCase::QUICK);
   AddTestCase (new ReadFileTestCase, TestCase::QUICK);
   AddTestCase (new DiffTestCase, TestCase::QUICK);
+  AddTestCase (new BufferedWriteTestCase, TestCase::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite;
@@ -46,6 +46,12 @@ PcapFileWrapper::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&PcapFileWrapper::m_nanosecMode),
                    MakeBooleanChecker())
+    .AddAttribute ("WriteBufferSize",
+                   "Size in bytes of the buffer accumulating records before they are written to the file "
+                   "(0 writes every record immediately).",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&PcapFileWrapper::m_writeBufferSize),
+                   MakeUintegerChecker<uint32_t> ())
   ;
   return tid;
 }
@@ -94,6 +100,14 @@ PcapFileWrapper::Open (std::string const &filename, std::ios::openmode mode)
 {
   NS_LOG_FUNCTION (this << filename << mode);
   m_file.Open (filename, mode);
+  m_file.SetWriteBufferSize (m_writeBufferSize);
+}
+
+void
+PcapFileWrapper::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_file.Flush ();
 }
 
 void
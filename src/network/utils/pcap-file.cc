@@ -50,7 +50,8 @@ const uint16_t VERSION_MINOR = 4;             /**< Minor version of supported pc
 PcapFile::PcapFile ()
   : m_file (),
     m_swapMode (false),
-    m_nanosecMode (false)
+    m_nanosecMode (false),
+    m_writeBufferSize (0)
 {
   NS_LOG_FUNCTION (this);
   FatalImpl::RegisterStream (&m_file); 
@@ -88,9 +89,51 @@ void
 PcapFile::Close (void)
 {
   NS_LOG_FUNCTION (this);
+  DrainWriteBuffer ();
   m_file.close ();
 }
 
+void
+PcapFile::SetWriteBufferSize (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  DrainWriteBuffer ();
+  m_writeBufferSize = size;
+  m_writeBuffer.reserve (size);
+}
+
+void
+PcapFile::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  DrainWriteBuffer ();
+  m_file.flush ();
+}
+
+void
+PcapFile::DrainWriteBuffer (void)
+{
+  if (!m_writeBuffer.empty ())
+    {
+      NS_LOG_LOGIC ("Writing " << m_writeBuffer.size () << " buffered bytes");
+      m_file.write ((const char *)&m_writeBuffer[0], m_writeBuffer.size ());
+      m_writeBuffer.clear ();
+    }
+}
+
+uint8_t *
+PcapFile::ReserveWriteBuffer (uint32_t size)
+{
+  if (m_writeBuffer.size () + size > m_writeBufferSize)
+    {
+      DrainWriteBuffer ();
+    }
+  // a record larger than the buffer temporarily grows it
+  std::vector<uint8_t>::size_type offset = m_writeBuffer.size ();
+  m_writeBuffer.resize (offset + size);
+  return &m_writeBuffer[offset];
+}
+
 uint32_t
 PcapFile::GetMagic (void)
 {
@@ -206,6 +249,7 @@ PcapFile::WriteFileHeader (void)
   // If we're initializing the file, we need to write the pcap file header
   // at the start of the file.
   //
+  DrainWriteBuffer ();
   m_file.seekp (0, std::ios::beg);
  
   //
@@ -418,6 +462,22 @@ PcapFile::WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
       Swap (&header, &header);
     }
 
+  if (m_writeBufferSize > 0)
+    {
+      //
+      // Reserve room for the whole record, so that it is never split
+      // across two writes to the file.
+      //
+      uint8_t *buf = ReserveWriteBuffer (16 + inclLen);
+      std::memcpy (buf, &header.m_tsSec, sizeof(header.m_tsSec));
+      std::memcpy (buf + 4, &header.m_tsUsec, sizeof(header.m_tsUsec));
+      std::memcpy (buf + 8, &header.m_inclLen, sizeof(header.m_inclLen));
+      std::memcpy (buf + 12, &header.m_origLen, sizeof(header.m_origLen));
+      // the record data will be copied right after the header
+      m_writeBuffer.resize (m_writeBuffer.size () - inclLen);
+      return inclLen;
+    }
+
   //
   // Watch out for memory alignment differences between machines, so write
   // them all individually.
@@ -435,6 +495,11 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, uint8_t const * const data, ui
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << &data << totalLen);
   uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, totalLen);
+  if (m_writeBufferSize > 0)
+    {
+      m_writeBuffer.insert (m_writeBuffer.end (), data, data + inclLen);
+      return;
+    }
   m_file.write ((const char *)data, inclLen);
   NS_BUILD_DEBUG(m_file.flush());
 }
@@ -444,6 +509,13 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << p);
   uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, p->GetSize ());
+  if (m_writeBufferSize > 0)
+    {
+      std::vector<uint8_t>::size_type offset = m_writeBuffer.size ();
+      m_writeBuffer.resize (offset + inclLen);
+      p->CopyData (&m_writeBuffer[offset], inclLen);
+      return;
+    }
   p->CopyData (&m_file, inclLen);
   NS_BUILD_DEBUG(m_file.flush());
 }
@@ -460,6 +532,14 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, const Header &header, Ptr<cons
   headerBuffer.AddAtStart (headerSize);
   header.Serialize (headerBuffer.Begin ());
   uint32_t toCopy = std::min (headerSize, inclLen);
+  if (m_writeBufferSize > 0)
+    {
+      std::vector<uint8_t>::size_type offset = m_writeBuffer.size ();
+      m_writeBuffer.resize (offset + inclLen);
+      headerBuffer.CopyData (&m_writeBuffer[offset], toCopy);
+      p->CopyData (&m_writeBuffer[offset + toCopy], inclLen - toCopy);
+      return;
+    }
   headerBuffer.CopyData (&m_file, toCopy);
   inclLen -= toCopy;
   p->CopyData (&m_file, inclLen);
@@ -477,6 +557,7 @@ PcapFile::Read (
 {
   NS_LOG_FUNCTION (this << &data <<maxBytes << tsSec << tsUsec << inclLen << origLen << readLen);
   NS_ASSERT (m_file.good ());
+  DrainWriteBuffer ();
 
   PcapRecordHeader header;
 
@@ -23,6 +23,7 @@
 
 #include <string>
 #include <fstream>
+#include <vector>
 #include <stdint.h>
 #include "ns3/ptr.h"
 
@@ -38,6 +39,12 @@ class Header;
  * A class representing a pcap file.  This allows easy creation, writing and 
  * reading of files composed of stored packets; which may be viewed using
  * standard tools.
+ *
+ * By default every record is handed to the underlying stream as soon as
+ * it is written (and, in debug builds, flushed).  When many files are
+ * written at high rate this turns the simulation I/O-bound; a write
+ * buffer can then be enabled with SetWriteBufferSize, so that records are
+ * accumulated in memory and handed to the stream in large blocks.
  */
 class PcapFile
 {
@@ -81,10 +88,28 @@ public:
   void Open (std::string const &filename, std::ios::openmode mode);
 
   /**
-   * Close the underlying file.
+   * Close the underlying file.  Any buffered record is written first.
    */
   void Close (void);
 
+  /**
+   * \brief Set the size of the write buffer
+   *
+   * Records are accumulated in a memory buffer of the given size and
+   * written to the file when the buffer is full, when Flush is called or
+   * when the file is closed.  A size of zero (the default) disables the
+   * buffer, and records are written immediately.  Any record already
+   * buffered is written before the size is changed.
+   *
+   * \param size the size of the write buffer, in bytes
+   */
+  void SetWriteBufferSize (uint32_t size);
+
+  /**
+   * \brief Write the buffered records to the file and flush the file.
+   */
+  void Flush (void);
+
   /**
    * Initialize the pcap file associated with this object.  This file must have
    * been previously opened with write permissions.
@@ -366,11 +391,29 @@ private:
    */
   void ReadAndVerifyFileHeader (void);
 
+  /**
+   * \brief Reserve space at the end of the write buffer
+   *
+   * The buffered records are written to the file first if the new data
+   * would not fit in the buffer.
+   *
+   * \param size the number of bytes to reserve
+   * \returns a pointer to the reserved space
+   */
+  uint8_t * ReserveWriteBuffer (uint32_t size);
+
+  /**
+   * \brief Write the content of the write buffer to the file
+   */
+  void DrainWriteBuffer (void);
+
   std::string    m_filename;    //!< file name
   std::fstream   m_file;        //!< file stream
   PcapFileHeader m_fileHeader;  //!< file header
   bool m_swapMode;              //!< swap mode
   bool m_nanosecMode;           //!< nanosecond timestamp mode
+  uint32_t m_writeBufferSize;   //!< size of the write buffer (0 if unbuffered)
+  std::vector<uint8_t> m_writeBuffer; //!< records not yet written to the file
 };
 
 } // namespace ns3
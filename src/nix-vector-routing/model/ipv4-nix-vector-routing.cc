@@ -24,6 +24,7 @@
 #include "ns3/log.h"
 #include "ns3/abort.h"
 #include "ns3/names.h"
+#include "ns3/uinteger.h"
 #include "ns3/ipv4-list-routing.h"
 
 #include "ipv4-nix-vector-routing.h"
@@ -35,6 +36,8 @@ NS_LOG_COMPONENT_DEFINE ("Ipv4NixVectorRouting");
 NS_OBJECT_ENSURE_REGISTERED (Ipv4NixVectorRouting);
 
 bool Ipv4NixVectorRouting::g_isCacheDirty = false;
+Ipv4AddressNodeMap_t Ipv4NixVectorRouting::g_nodeIdCache;
+std::list<const Ipv4NixVectorRouting *> Ipv4NixVectorRouting::g_treeOwners;
 
 TypeId 
 Ipv4NixVectorRouting::GetTypeId (void)
@@ -43,12 +46,21 @@ Ipv4NixVectorRouting::GetTypeId (void)
     .SetParent<Ipv4RoutingProtocol> ()
     .SetGroupName ("NixVectorRouting")
     .AddConstructor<Ipv4NixVectorRouting> ()
+    .AddAttribute ("MaxCachedTrees",
+                   "The maximum number of nodes keeping the shortest path tree "
+                   "of their nix-vectors; the least recently used trees are "
+                   "dropped beyond it. Zero disables the trees, one BFS then "
+                   "being run for each destination.",
+                   UintegerValue (256),
+                   MakeUintegerAccessor (&Ipv4NixVectorRouting::m_maxCachedTrees),
+                   MakeUintegerChecker<uint32_t> ())
   ;
   return tid;
 }
 
 Ipv4NixVectorRouting::Ipv4NixVectorRouting ()
-  : m_totalNeighbors (0)
+  : m_isTreeOwner (false),
+    m_totalNeighbors (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -56,6 +68,8 @@ Ipv4NixVectorRouting::Ipv4NixVectorRouting ()
 Ipv4NixVectorRouting::~Ipv4NixVectorRouting ()
 {
   NS_LOG_FUNCTION_NOARGS ();
+  // an agent in an Ipv4ListRouting may be freed without being disposed
+  DropParentVector ();
 }
 
 void
@@ -75,6 +89,7 @@ Ipv4NixVectorRouting::DoDispose ()
 
   m_node = 0;
   m_ipv4 = 0;
+  DropParentVector ();
 
   Ipv4RoutingProtocol::DoDispose ();
 }
@@ -105,6 +120,7 @@ Ipv4NixVectorRouting::FlushGlobalNixRoutingCache (void) const
       rp->FlushNixCache ();
       rp->FlushIpv4RouteCache ();
     }
+  g_nodeIdCache.clear ();
 }
 
 void
@@ -112,6 +128,37 @@ Ipv4NixVectorRouting::FlushNixCache (void) const
 {
   NS_LOG_FUNCTION_NOARGS ();
   m_nixCache.clear ();
+  DropParentVector ();
+}
+
+void
+Ipv4NixVectorRouting::UseParentVector (void) const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  if (m_isTreeOwner)
+    {
+      g_treeOwners.splice (g_treeOwners.begin (), g_treeOwners, m_treeOwner);
+      return;
+    }
+  while (!g_treeOwners.empty () && g_treeOwners.size () >= m_maxCachedTrees)
+    {
+      NS_LOG_LOGIC ("Dropping the least recently used tree");
+      g_treeOwners.back ()->DropParentVector ();
+    }
+  m_treeOwner = g_treeOwners.insert (g_treeOwners.begin (), this);
+  m_isTreeOwner = true;
+}
+
+void
+Ipv4NixVectorRouting::DropParentVector (void) const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_parentVector.clear ();
+  if (m_isTreeOwner)
+    {
+      g_treeOwners.erase (m_treeOwner);
+      m_isTreeOwner = false;
+    }
 }
 
 void
@@ -151,10 +198,26 @@ Ipv4NixVectorRouting::GetNixVector (Ptr<Node> source, Ipv4Address dest, Ptr<NetD
       // otherwise proceed as normal 
       // and build the nix vector
       std::vector< Ptr<Node> > parentVector;
+      const std::vector< Ptr<Node> > *tree = &parentVector;
 
-      BFS (NodeList::GetNNodes (), source, destNode, parentVector, oif);
+      if (source == m_node && oif == 0 && m_maxCachedTrees > 0)
+        {
+          // the BFS over the whole topology serves all the
+          // destinations, until the topology changes or the
+          // tree is dropped for the ones of other nodes
+          UseParentVector ();
+          if (m_parentVector.size () != NodeList::GetNNodes ())
+            {
+              BFS (NodeList::GetNNodes (), source, 0, m_parentVector, oif);
+            }
+          tree = &m_parentVector;
+        }
+      else
+        {
+          BFS (NodeList::GetNNodes (), source, destNode, parentVector, oif);
+        }
 
-      if (BuildNixVector (parentVector, source->GetId (), destNode->GetId (), nixVector))
+      if (BuildNixVector (*tree, source->GetId (), destNode->GetId (), nixVector))
         {
           return nixVector;
         }
@@ -347,6 +410,18 @@ Ipv4NixVectorRouting::GetNodeByIp (Ipv4Address dest)
 { 
   NS_LOG_FUNCTION_NOARGS ();
 
+  Ipv4AddressNodeMap_t::const_iterator cached = g_nodeIdCache.find (dest);
+  if (cached != g_nodeIdCache.end () && cached->second < NodeList::GetNNodes ())
+    {
+      // the node list may have been rebuilt since
+      Ptr<Node> node = NodeList::GetNode (cached->second);
+      Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+      if (ipv4 && ipv4->GetInterfaceForAddress (dest) != -1)
+        {
+          return node;
+        }
+    }
+
   NodeContainer allNodes = NodeContainer::GetGlobal ();
   Ptr<Node> destNode;
 
@@ -367,6 +442,7 @@ Ipv4NixVectorRouting::GetNodeByIp (Ipv4Address dest)
       return 0;
     }
 
+  g_nodeIdCache[dest] = destNode->GetId ();
   return destNode;
 }
 
@@ -777,13 +853,19 @@ Ipv4NixVectorRouting::BFS (uint32_t numberOfNodes, Ptr<Node> source,
 {
   NS_LOG_FUNCTION_NOARGS ();
 
-  NS_LOG_LOGIC ("Going from Node " << source->GetId () << " to Node " << dest->GetId ());
+  if (dest)
+    {
+      NS_LOG_LOGIC ("Going from Node " << source->GetId () << " to Node " << dest->GetId ());
+    }
+  else
+    {
+      NS_LOG_LOGIC ("Going from Node " << source->GetId () << " to all nodes");
+    }
   std::queue< Ptr<Node> > greyNodeList;  // discovered nodes with unexplored children
 
   // reset the parent vector
   parentVector.clear ();
-  parentVector.reserve (sizeof (Ptr<Node>)*numberOfNodes);
-  parentVector.insert (parentVector.begin (), sizeof (Ptr<Node>)*numberOfNodes, 0); // initialize to 0
+  parentVector.resize (numberOfNodes); // initialize to 0
 
   // Add the source node to the queue, set its parent to itself 
   greyNodeList.push (source);
@@ -22,6 +22,7 @@
 #define IPV4_NIX_VECTOR_ROUTING_H
 
 #include <map>
+#include <list>
 
 #include "ns3/channel.h"
 #include "ns3/node-container.h"
@@ -32,6 +33,8 @@
 #include "ns3/nix-vector.h"
 #include "ns3/bridge-net-device.h"
 
+class NixVectorRoutingTreeTest;
+
 namespace ns3 {
 
 /**
@@ -44,6 +47,11 @@ typedef std::map<Ipv4Address, Ptr<NixVector> > NixMap_t;
  * Map of Ipv4Address to Ipv4Route
  */
 typedef std::map<Ipv4Address, Ptr<Ipv4Route> > Ipv4RouteMap_t;
+/**
+ * \ingroup nix-vector-routing
+ * Map of Ipv4Address to node id
+ */
+typedef std::map<Ipv4Address, uint32_t> Ipv4AddressNodeMap_t;
 
 /**
  * \ingroup nix-vector-routing
@@ -83,9 +91,18 @@ public:
 private:
 
   /* flushes the cache which stores nix-vector based on
-   * destination IP */
+   * destination IP, and the shortest path tree they are
+   * built from */
   void FlushNixCache (void) const;
 
+  /* marks the shortest path tree of this node as the most
+   * recently used one, dropping the least recently used trees
+   * of the other nodes beyond MaxCachedTrees */
+  void UseParentVector (void) const;
+
+  /* drops the shortest path tree of this node */
+  void DropParentVector (void) const;
+
   /* flushes the cache which stores the Ipv4 route
    * based on the destination IP */
   void FlushIpv4RouteCache (void) const;
@@ -110,8 +127,9 @@ private:
    * essentially getting the neighbors on that channel */
   void GetAdjacentNetDevices (Ptr<NetDevice>, Ptr<Channel>, NetDeviceContainer &);
 
-  /* iterates through the node list and finds the one
-   * corresponding to the given Ipv4Address */
+  /* finds the node corresponding to the given Ipv4Address,
+   * iterating through the node list the first time an address
+   * is looked up */
   Ptr<Node> GetNodeByIp (Ipv4Address);
 
   /* Recurses the parent vector, created by BFS and actually builds the nixvector */
@@ -135,7 +153,7 @@ private:
   /* Breadth first search algorithm
    * Param1: total number of nodes
    * Param2: Source Node
-   * Param3: Dest Node
+   * Param3: Dest Node, or 0 to visit all the reachable nodes
    * Param4: (returned) Parent vector for retracing routes
    * Param5: specific output interface to use from source node, if not null
    * Returns: false if dest not found, true o.w.
@@ -171,18 +189,43 @@ private:
    */
   static bool g_isCacheDirty;
 
+  /* Cache stores the node ids found by GetNodeByIp, shared
+   * by all the nodes and flushed with their caches */
+  static Ipv4AddressNodeMap_t g_nodeIdCache;
+
   /* Cache stores nix-vectors based on destination ip */
   mutable NixMap_t m_nixCache;
 
   /* Cache stores Ipv4Routes based on destination ip */
   mutable Ipv4RouteMap_t m_ipv4RouteCache;
 
+  /* Parent vector of the BFS over the whole topology from this
+   * node, from which the nix-vectors of all the destinations are
+   * built without any further BFS, as long as no specific output
+   * interface is requested */
+  mutable std::vector< Ptr<Node> > m_parentVector;
+
+  /* Nodes keeping their parent vector, the most recently
+   * used first */
+  static std::list<const Ipv4NixVectorRouting *> g_treeOwners;
+
+  /* Position of this node in g_treeOwners, if m_isTreeOwner */
+  mutable std::list<const Ipv4NixVectorRouting *>::iterator m_treeOwner;
+
+  /* Whether this node is in g_treeOwners */
+  mutable bool m_isTreeOwner;
+
+  /* Maximum number of nodes keeping their parent vector */
+  uint32_t m_maxCachedTrees;
+
   Ptr<Ipv4> m_ipv4;
   Ptr<Node> m_node;
 
   /* Total neighbors used for nix-vector to determine
    * number of bits */
   uint32_t m_totalNeighbors;
+
+  friend class ::NixVectorRoutingTreeTest; // To compare the nix-vectors built from the trees
 };
 } // namespace ns3
 
@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/node-container.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-nix-vector-helper.h"
+#include "ns3/ipv4-nix-vector-routing.h"
+
+using namespace ns3;
+
+/**
+ * Check that the nix-vectors built from the shortest path tree kept by
+ * each node are the ones built from a BFS run for each destination, also
+ * when the trees of the least recently used nodes are dropped and after
+ * the caches are flushed on a topology change.
+ */
+class NixVectorRoutingTreeTest : public TestCase
+{
+public:
+  NixVectorRoutingTreeTest ();
+  virtual ~NixVectorRoutingTreeTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Compare the nix-vectors of all the pairs of nodes
+   * \param nodes the nodes
+   * \param maxTrees the maximum number of nodes keeping their tree
+   */
+  void CheckNixVectors (NodeContainer nodes, uint32_t maxTrees);
+  /**
+   * Count the nodes keeping their tree
+   * \param nodes the nodes
+   * \returns the number of non empty parent vectors
+   */
+  uint32_t CountTrees (NodeContainer nodes);
+};
+
+NixVectorRoutingTreeTest::NixVectorRoutingTreeTest ()
+  : TestCase ("Nix-vectors built from the cached shortest path trees")
+{
+}
+
+NixVectorRoutingTreeTest::~NixVectorRoutingTreeTest ()
+{
+}
+
+uint32_t
+NixVectorRoutingTreeTest::CountTrees (NodeContainer nodes)
+{
+  uint32_t trees = 0;
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      if (!nodes.Get (i)->GetObject<Ipv4NixVectorRouting> ()->m_parentVector.empty ())
+        {
+          trees++;
+        }
+    }
+  return trees;
+}
+
+void
+NixVectorRoutingTreeTest::CheckNixVectors (NodeContainer nodes, uint32_t maxTrees)
+{
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<Node> source = nodes.Get (i);
+      Ptr<Ipv4NixVectorRouting> rp = source->GetObject<Ipv4NixVectorRouting> ();
+      for (uint32_t j = 0; j < nodes.GetN (); j++)
+        {
+          Ptr<Node> dest = nodes.Get (j);
+          if (dest == source)
+            {
+              continue;
+            }
+          Ptr<Ipv4> ipv4 = dest->GetObject<Ipv4> ();
+          for (uint32_t k = 1; k < ipv4->GetNInterfaces (); k++)
+            {
+              Ipv4Address address = ipv4->GetAddress (k, 0).GetLocal ();
+              Ptr<NixVector> nixVector = rp->GetNixVector (source, address, 0);
+
+              std::vector< Ptr<Node> > parentVector;
+              Ptr<NixVector> expected = Create<NixVector> ();
+              bool found = rp->BFS (NodeList::GetNNodes (), source, dest, parentVector, 0);
+              if (!found)
+                {
+                  NS_TEST_EXPECT_MSG_EQ ((nixVector == 0), true,
+                                         "Unexpected nix-vector from node " << i << " to " << address);
+                  continue;
+                }
+              rp->BuildNixVector (parentVector, source->GetId (), dest->GetId (), expected);
+              NS_TEST_ASSERT_MSG_EQ ((nixVector != 0), true,
+                                     "No nix-vector from node " << i << " to " << address);
+              std::ostringstream actualBits;
+              std::ostringstream expectedBits;
+              actualBits << *nixVector;
+              expectedBits << *expected;
+              NS_TEST_EXPECT_MSG_EQ (actualBits.str (), expectedBits.str (),
+                                     "Wrong nix-vector from node " << i << " to " << address);
+              NS_TEST_EXPECT_MSG_EQ (nixVector->GetRemainingBits (), expected->GetRemainingBits (),
+                                     "Wrong nix-vector length from node " << i << " to " << address);
+            }
+          NS_TEST_EXPECT_MSG_LT_OR_EQ (CountTrees (nodes), maxTrees, "Too many trees kept");
+        }
+    }
+}
+
+void
+NixVectorRoutingTreeTest::DoRun (void)
+{
+  // 0 reaches 3 through 1 or 2, and 1, 4 and 5 share a channel
+  NodeContainer nodes;
+  nodes.Create (6);
+  SimpleNetDeviceHelper simple;
+  InternetStackHelper stack;
+  Ipv4NixVectorHelper nixRouting;
+  stack.SetRoutingHelper (nixRouting);
+  stack.Install (nodes);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  uint32_t links[][2] = { {0, 1}, {0, 2}, {1, 3}, {2, 3}, {3, 4} };
+  for (uint32_t i = 0; i < sizeof (links) / sizeof (links[0]); i++)
+    {
+      address.Assign (simple.Install (NodeContainer (nodes.Get (links[i][0]), nodes.Get (links[i][1]))));
+      address.NewNetwork ();
+    }
+  NodeContainer shared (nodes.Get (1), nodes.Get (4), nodes.Get (5));
+  address.Assign (simple.Install (shared));
+
+  const uint32_t maxTrees = 2;
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      nodes.Get (i)->GetObject<Ipv4NixVectorRouting> ()->SetAttribute ("MaxCachedTrees", UintegerValue (maxTrees));
+    }
+
+  CheckNixVectors (nodes, maxTrees);
+  NS_TEST_EXPECT_MSG_EQ (CountTrees (nodes), maxTrees, "The most recently used trees should be kept");
+
+  // take the 1-3 link down: the trees are dropped with the nix-vectors,
+  // and 0 now reaches 3 through 2
+  Ptr<Ipv4> ipv4 = nodes.Get (1)->GetObject<Ipv4> ();
+  ipv4->SetDown (ipv4->GetInterfaceForDevice (nodes.Get (1)->GetDevice (2)));
+  Ptr<Ipv4NixVectorRouting> rp = nodes.Get (0)->GetObject<Ipv4NixVectorRouting> ();
+  rp->CheckCacheStateAndFlush ();
+  NS_TEST_EXPECT_MSG_EQ (CountTrees (nodes), 0, "The trees should be dropped with the caches");
+
+  CheckNixVectors (nodes, maxTrees);
+
+  // an agent freed without being disposed, as in an Ipv4ListRouting,
+  // leaves no dangling tree owner behind
+  {
+    Ptr<Ipv4NixVectorRouting> agent = CreateObject<Ipv4NixVectorRouting> ();
+    agent->SetAttribute ("MaxCachedTrees", UintegerValue (maxTrees));
+    agent->SetNode (nodes.Get (5));
+    Ptr<Ipv4> destIpv4 = nodes.Get (0)->GetObject<Ipv4> ();
+    agent->GetNixVector (nodes.Get (5), destIpv4->GetAddress (1, 0).GetLocal (), 0);
+    NS_TEST_EXPECT_MSG_EQ (agent->m_parentVector.empty (), false, "The agent should keep its tree");
+  }
+  NS_TEST_EXPECT_MSG_EQ (Ipv4NixVectorRouting::g_treeOwners.size (), CountTrees (nodes),
+                         "The freed agent is still a tree owner");
+  CheckNixVectors (nodes, maxTrees);
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup nix-vector-routing
+ * The nix-vector routing test suite
+ */
+class NixVectorRoutingTestSuite : public TestSuite
+{
+public:
+  NixVectorRoutingTestSuite ();
+};
+
+NixVectorRoutingTestSuite::NixVectorRoutingTestSuite ()
+  : TestSuite ("nix-vector-routing", UNIT)
+{
+  AddTestCase (new NixVectorRoutingTreeTest, TestCase::QUICK);
+}
+
+static NixVectorRoutingTestSuite g_nixVectorRoutingTestSuite; ///< the test suite
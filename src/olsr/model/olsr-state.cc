@@ -26,7 +26,9 @@
 ///		state of an OLSR node.
 ///
 
+#include <algorithm>
 #include "olsr-state.h"
+#include "ns3/assert.h"
 
 
 namespace ns3 {
@@ -293,34 +295,44 @@ OlsrState::GetMprSet () const
 DuplicateTuple*
 OlsrState::FindDuplicateTuple (Ipv4Address const &addr, uint16_t sequenceNumber)
 {
-  for (DuplicateSet::iterator it = m_duplicateSet.begin ();
-       it != m_duplicateSet.end (); it++)
+  std::map<std::pair<Ipv4Address, uint16_t>, uint32_t>::const_iterator it =
+    m_duplicateIndex.find (std::make_pair (addr, sequenceNumber));
+  if (it == m_duplicateIndex.end ())
     {
-      if (it->address == addr && it->sequenceNumber == sequenceNumber)
-        {
-          return &(*it);
-        }
+      return NULL;
     }
-  return NULL;
+  return &m_duplicateSet[it->second];
 }
 
 void
 OlsrState::EraseDuplicateTuple (const DuplicateTuple &tuple)
 {
-  for (DuplicateSet::iterator it = m_duplicateSet.begin ();
-       it != m_duplicateSet.end (); it++)
+  std::map<std::pair<Ipv4Address, uint16_t>, uint32_t>::iterator it =
+    m_duplicateIndex.find (std::make_pair (tuple.address, tuple.sequenceNumber));
+  if (it == m_duplicateIndex.end ())
     {
-      if (*it == tuple)
-        {
-          m_duplicateSet.erase (it);
-          break;
-        }
+      return;
+    }
+  uint32_t position = it->second;
+  m_duplicateIndex.erase (it);
+  // The order of the duplicate set does not matter: the last tuple
+  // takes the place of the erased one.
+  if (position + 1 != m_duplicateSet.size ())
+    {
+      std::swap (m_duplicateSet[position], m_duplicateSet.back ());
+      const DuplicateTuple &moved = m_duplicateSet[position];
+      m_duplicateIndex[std::make_pair (moved.address, moved.sequenceNumber)] = position;
     }
+  m_duplicateSet.pop_back ();
 }
 
 void
 OlsrState::InsertDuplicateTuple (DuplicateTuple const &tuple)
 {
+  std::pair<std::map<std::pair<Ipv4Address, uint16_t>, uint32_t>::iterator, bool> result =
+    m_duplicateIndex.insert (std::make_pair (std::make_pair (tuple.address, tuple.sequenceNumber),
+                                             static_cast<uint32_t> (m_duplicateSet.size ())));
+  NS_ASSERT_MSG (result.second, "Duplicate tuple inserted twice");
   m_duplicateSet.push_back (tuple);
 }
 
@@ -388,68 +400,111 @@ TopologyTuple*
 OlsrState::FindTopologyTuple (Ipv4Address const &destAddr,
                               Ipv4Address const &lastAddr)
 {
-  for (TopologySet::iterator it = m_topologySet.begin ();
-       it != m_topologySet.end (); it++)
+  std::map<std::pair<Ipv4Address, Ipv4Address>, uint32_t>::const_iterator it =
+    m_topologyIndex.find (std::make_pair (lastAddr, destAddr));
+  if (it == m_topologyIndex.end ())
     {
-      if (it->destAddr == destAddr && it->lastAddr == lastAddr)
-        {
-          return &(*it);
-        }
+      return NULL;
     }
-  return NULL;
+  return &m_topologySet[it->second];
 }
 
 TopologyTuple*
 OlsrState::FindNewerTopologyTuple (Ipv4Address const & lastAddr, uint16_t ansn)
 {
-  for (TopologySet::iterator it = m_topologySet.begin ();
-       it != m_topologySet.end (); it++)
+  // The tuples with the same last address are contiguous in the index.
+  TopologyTuple *newer = NULL;
+  for (std::map<std::pair<Ipv4Address, Ipv4Address>, uint32_t>::const_iterator it =
+         m_topologyIndex.lower_bound (std::make_pair (lastAddr, Ipv4Address (0u)));
+       it != m_topologyIndex.end () && it->first.first == lastAddr; it++)
     {
-      if (it->lastAddr == lastAddr && it->sequenceNumber > ansn)
+      TopologyTuple *tuple = &m_topologySet[it->second];
+      if (tuple->sequenceNumber > ansn && (newer == NULL || tuple < newer))
         {
-          return &(*it);
+          newer = tuple;
         }
     }
-  return NULL;
+  return newer;
 }
 
 void
 OlsrState::EraseTopologyTuple (const TopologyTuple &tuple)
 {
-  for (TopologySet::iterator it = m_topologySet.begin ();
-       it != m_topologySet.end (); it++)
+  std::map<std::pair<Ipv4Address, Ipv4Address>, uint32_t>::iterator it =
+    m_topologyIndex.find (std::make_pair (tuple.lastAddr, tuple.destAddr));
+  if (it == m_topologyIndex.end ()
+      || m_topologySet[it->second].sequenceNumber != tuple.sequenceNumber)
     {
-      if (*it == tuple)
-        {
-          m_topologySet.erase (it);
-          break;
-        }
+      return;
     }
+  uint32_t position = it->second;
+  m_topologyIndex.erase (it);
+  m_topologySet.erase (m_topologySet.begin () + position);
+  UpdateTopologyIndex (position);
 }
 
 void
 OlsrState::EraseOlderTopologyTuples (const Ipv4Address &lastAddr, uint16_t ansn)
 {
-  for (TopologySet::iterator it = m_topologySet.begin ();
-       it != m_topologySet.end (); )
+  std::vector<uint32_t> older;
+  for (std::map<std::pair<Ipv4Address, Ipv4Address>, uint32_t>::iterator it =
+         m_topologyIndex.lower_bound (std::make_pair (lastAddr, Ipv4Address (0u)));
+       it != m_topologyIndex.end () && it->first.first == lastAddr; )
     {
-      if (it->lastAddr == lastAddr && it->sequenceNumber < ansn)
+      if (m_topologySet[it->second].sequenceNumber < ansn)
         {
-          it = m_topologySet.erase (it);
+          older.push_back (it->second);
+          m_topologyIndex.erase (it++);
         }
       else
         {
           it++;
         }
     }
+  if (older.empty ())
+    {
+      return;
+    }
+
+  // Remove the tuples in a single pass, keeping the order of the others.
+  std::sort (older.begin (), older.end ());
+  uint32_t next = 0;
+  uint32_t kept = older[0];
+  for (uint32_t i = older[0]; i < m_topologySet.size (); i++)
+    {
+      if (next < older.size () && older[next] == i)
+        {
+          next++;
+        }
+      else
+        {
+          m_topologySet[kept++] = m_topologySet[i];
+        }
+    }
+  m_topologySet.erase (m_topologySet.begin () + kept, m_topologySet.end ());
+  UpdateTopologyIndex (older[0]);
 }
 
 void
 OlsrState::InsertTopologyTuple (TopologyTuple const &tuple)
 {
+  std::pair<std::map<std::pair<Ipv4Address, Ipv4Address>, uint32_t>::iterator, bool> result =
+    m_topologyIndex.insert (std::make_pair (std::make_pair (tuple.lastAddr, tuple.destAddr),
+                                            static_cast<uint32_t> (m_topologySet.size ())));
+  NS_ASSERT_MSG (result.second, "Topology tuple inserted twice");
   m_topologySet.push_back (tuple);
 }
 
+void
+OlsrState::UpdateTopologyIndex (uint32_t first)
+{
+  for (uint32_t i = first; i < m_topologySet.size (); i++)
+    {
+      const TopologyTuple &tuple = m_topologySet[i];
+      m_topologyIndex[std::make_pair (tuple.lastAddr, tuple.destAddr)] = i;
+    }
+}
+
 /********** Interface Association Set Manipulation **********/
 
 IfaceAssocTuple*
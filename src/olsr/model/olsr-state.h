@@ -25,6 +25,8 @@
 #ifndef OLSR_STATE_H
 #define OLSR_STATE_H
 
+#include <map>
+#include <utility>
 #include "olsr-repositories.h"
 
 namespace ns3 {
@@ -48,6 +50,17 @@ protected:
   AssociationSet m_associationSet; //!<	Association Set (\RFC{3626}, section12.2). Associations obtained from HNA messages generated by other nodes.
   Associations m_associations;  //!< The node's local Host Network Associations that will be advertised using HNA messages.
 
+  /// Position of the tuples in m_duplicateSet, by originator address and sequence number.
+  std::map<std::pair<Ipv4Address, uint16_t>, uint32_t> m_duplicateIndex;
+  /// Position of the tuples in m_topologySet, by last and destination addresses.
+  std::map<std::pair<Ipv4Address, Ipv4Address>, uint32_t> m_topologyIndex;
+
+  /**
+   * Updates the position of the topology tuples which were moved.
+   * \param first The position of the first moved tuple.
+   */
+  void UpdateTopologyIndex (uint32_t first);
+
 public:
   OlsrState ()
   {
@@ -167,6 +167,89 @@ OlsrMprTestCase::DoRun ()
   NS_TEST_EXPECT_MSG_EQ ((mpr.find ("10.0.0.9") == mpr.end ()), true, "Node 1 must NOT select node 8 as MPR");
 }
 
+/// Testcase for the indexed duplicate and topology sets
+class OlsrStateTestCase : public TestCase
+{
+public:
+  OlsrStateTestCase ();
+  ~OlsrStateTestCase ();
+  /// \brief Run test case
+  virtual void DoRun (void);
+};
+
+
+OlsrStateTestCase::OlsrStateTestCase ()
+  : TestCase ("Check OLSR duplicate and topology sets")
+{
+}
+OlsrStateTestCase::~OlsrStateTestCase ()
+{
+}
+void
+OlsrStateTestCase::DoRun ()
+{
+  OlsrState state;
+
+  DuplicateTuple duplicate;
+  duplicate.retransmitted = false;
+  for (uint16_t i = 0; i < 4; i++)
+    {
+      duplicate.address = Ipv4Address ("10.0.0.1");
+      duplicate.sequenceNumber = i;
+      state.InsertDuplicateTuple (duplicate);
+      duplicate.address = Ipv4Address ("10.0.0.2");
+      state.InsertDuplicateTuple (duplicate);
+    }
+  duplicate.address = Ipv4Address ("10.0.0.1");
+  duplicate.sequenceNumber = 1;
+  state.EraseDuplicateTuple (duplicate);
+  NS_TEST_EXPECT_MSG_EQ ((state.FindDuplicateTuple ("10.0.0.1", 1) == 0), true, "Erased duplicate tuple found");
+  for (uint16_t i = 0; i < 4; i++)
+    {
+      DuplicateTuple *found = state.FindDuplicateTuple ("10.0.0.2", i);
+      NS_TEST_ASSERT_MSG_EQ ((found != 0), true, "Duplicate tuple not found");
+      NS_TEST_EXPECT_MSG_EQ (found->address, Ipv4Address ("10.0.0.2"), "Wrong duplicate tuple");
+      NS_TEST_EXPECT_MSG_EQ (found->sequenceNumber, i, "Wrong duplicate tuple");
+    }
+  NS_TEST_EXPECT_MSG_EQ ((state.FindDuplicateTuple ("10.0.0.1", 3) != 0), true, "Duplicate tuple not found");
+
+  /*
+   * 10.0.0.1 advertises 10.0.0.3 and 10.0.0.4 with ANSN 1,
+   * 10.0.0.2 advertises 10.0.0.3 with ANSN 1 and 10.0.0.5 with ANSN 2
+   */
+  TopologyTuple topology;
+  topology.lastAddr = Ipv4Address ("10.0.0.1");
+  topology.sequenceNumber = 1;
+  topology.destAddr = Ipv4Address ("10.0.0.3");
+  state.InsertTopologyTuple (topology);
+  topology.lastAddr = Ipv4Address ("10.0.0.2");
+  state.InsertTopologyTuple (topology);
+  topology.lastAddr = Ipv4Address ("10.0.0.1");
+  topology.destAddr = Ipv4Address ("10.0.0.4");
+  state.InsertTopologyTuple (topology);
+  topology.lastAddr = Ipv4Address ("10.0.0.2");
+  topology.destAddr = Ipv4Address ("10.0.0.5");
+  topology.sequenceNumber = 2;
+  state.InsertTopologyTuple (topology);
+
+  NS_TEST_EXPECT_MSG_EQ ((state.FindNewerTopologyTuple ("10.0.0.1", 1) == 0), true, "No newer tuple expected");
+  NS_TEST_EXPECT_MSG_EQ ((state.FindNewerTopologyTuple ("10.0.0.2", 1) != 0), true, "Newer tuple expected");
+  state.EraseOlderTopologyTuples ("10.0.0.2", 2);
+  NS_TEST_ASSERT_MSG_EQ (state.GetTopologySet ().size (), 3, "One tuple should have been erased");
+  NS_TEST_EXPECT_MSG_EQ ((state.FindTopologyTuple ("10.0.0.3", "10.0.0.2") == 0), true, "Erased tuple found");
+  // the other tuples keep their order
+  NS_TEST_EXPECT_MSG_EQ (state.GetTopologySet ()[0].destAddr, Ipv4Address ("10.0.0.3"), "Wrong order");
+  NS_TEST_EXPECT_MSG_EQ (state.GetTopologySet ()[1].destAddr, Ipv4Address ("10.0.0.4"), "Wrong order");
+  NS_TEST_EXPECT_MSG_EQ (state.GetTopologySet ()[2].destAddr, Ipv4Address ("10.0.0.5"), "Wrong order");
+  NS_TEST_EXPECT_MSG_EQ (state.FindTopologyTuple ("10.0.0.5", "10.0.0.2"), &state.GetTopologySet ()[2], "Wrong tuple");
+
+  topology = *state.FindTopologyTuple ("10.0.0.3", "10.0.0.1");
+  state.EraseTopologyTuple (topology);
+  NS_TEST_ASSERT_MSG_EQ (state.GetTopologySet ().size (), 2, "One tuple should have been erased");
+  NS_TEST_EXPECT_MSG_EQ (state.FindTopologyTuple ("10.0.0.4", "10.0.0.1"), &state.GetTopologySet ()[0], "Wrong tuple");
+  NS_TEST_EXPECT_MSG_EQ (state.FindTopologyTuple ("10.0.0.5", "10.0.0.2"), &state.GetTopologySet ()[1], "Wrong tuple");
+}
+
 static class OlsrProtocolTestSuite : public TestSuite
 {
 public:
@@ -177,4 +260,5 @@ OlsrProtocolTestSuite::OlsrProtocolTestSuite ()
   : TestSuite ("routing-olsr", UNIT)
 {
   AddTestCase (new OlsrMprTestCase (), TestCase::QUICK);
+  AddTestCase (new OlsrStateTestCase (), TestCase::QUICK);
 }
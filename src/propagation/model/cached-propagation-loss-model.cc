@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include "cached-propagation-loss-model.h"
+#include "ns3/pointer.h"
+#include "ns3/callback.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("CachedPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED (CachedPropagationLossModel);
+
+TypeId
+CachedPropagationLossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CachedPropagationLossModel")
+    .SetParent<PropagationLossModel> ()
+    .SetGroupName ("Propagation")
+    .AddConstructor<CachedPropagationLossModel> ()
+    .AddAttribute ("Model", "The propagation loss model whose loss is cached.",
+                   PointerValue (),
+                   MakePointerAccessor (&CachedPropagationLossModel::SetModel,
+                                        &CachedPropagationLossModel::GetModel),
+                   MakePointerChecker<PropagationLossModel> ())
+  ;
+  return tid;
+}
+
+CachedPropagationLossModel::CachedPropagationLossModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+CachedPropagationLossModel::~CachedPropagationLossModel ()
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+}
+
+void
+CachedPropagationLossModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+  m_model = 0;
+  PropagationLossModel::DoDispose ();
+}
+
+void
+CachedPropagationLossModel::SetModel (Ptr<PropagationLossModel> model)
+{
+  NS_LOG_FUNCTION (this << model);
+  Clear ();
+  m_model = model;
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModel::GetModel (void) const
+{
+  return m_model;
+}
+
+void
+CachedPropagationLossModel::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::unordered_map<const MobilityModel *, Node>::iterator i = m_nodes.begin (); i != m_nodes.end (); ++i)
+    {
+      i->second.mobility->TraceDisconnectWithoutContext ("CourseChange",
+                                                         MakeCallback (&CachedPropagationLossModel::CourseChanged, this));
+    }
+  m_nodes.clear ();
+  m_gains.clear ();
+}
+
+uint32_t
+CachedPropagationLossModel::GetNCachedPaths (void) const
+{
+  return m_gains.size ();
+}
+
+std::size_t
+CachedPropagationLossModel::PathKeyHash::operator () (const PathKey &key) const
+{
+  std::size_t a = std::hash<const MobilityModel *> () (key.first);
+  std::size_t b = std::hash<const MobilityModel *> () (key.second);
+  return a ^ (b + 0x9e3779b9 + (a << 6) + (a >> 2));
+}
+
+CachedPropagationLossModel::Node &
+CachedPropagationLossModel::GetNode (Ptr<MobilityModel> mobility) const
+{
+  std::unordered_map<const MobilityModel *, Node>::iterator it = m_nodes.find (PeekPointer (mobility));
+  if (it != m_nodes.end ())
+    {
+      return it->second;
+    }
+  Node &node = m_nodes[PeekPointer (mobility)];
+  node.mobility = mobility;
+  node.isStatic = mobility->IsStationary ();
+  mobility->TraceConnectWithoutContext ("CourseChange",
+                                        MakeCallback (&CachedPropagationLossModel::CourseChanged,
+                                                      const_cast<CachedPropagationLossModel *> (this)));
+  return node;
+}
+
+void
+CachedPropagationLossModel::CourseChanged (Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  std::unordered_map<const MobilityModel *, Node>::iterator it = m_nodes.find (PeekPointer (mobility));
+  if (it == m_nodes.end ())
+    {
+      return;
+    }
+  Node &node = it->second;
+  for (std::vector<const MobilityModel *>::const_iterator peer = node.peers.begin (); peer != node.peers.end (); ++peer)
+    {
+      m_gains.erase (PathKey (PeekPointer (mobility), *peer));
+      m_gains.erase (PathKey (*peer, PeekPointer (mobility)));
+      if (*peer != PeekPointer (mobility))
+        {
+          std::vector<const MobilityModel *> &peers = m_nodes[*peer].peers;
+          std::vector<const MobilityModel *>::iterator self = std::find (peers.begin (), peers.end (), PeekPointer (mobility));
+          NS_ASSERT (self != peers.end ());
+          *self = peers.back ();
+          peers.pop_back ();
+        }
+    }
+  node.peers.clear ();
+  node.isStatic = mobility->IsStationary ();
+}
+
+double
+CachedPropagationLossModel::GetGain (Node &a, Node &b) const
+{
+  if (!a.isStatic || !b.isStatic)
+    {
+      return m_model->CalcRxPower (0.0, a.mobility, b.mobility);
+    }
+  PathKey key (PeekPointer (a.mobility), PeekPointer (b.mobility));
+  std::unordered_map<PathKey, double, PathKeyHash>::const_iterator it = m_gains.find (key);
+  if (it != m_gains.end ())
+    {
+      return it->second;
+    }
+  double gain = m_model->CalcRxPower (0.0, a.mobility, b.mobility);
+  // a path is listed once by each of its ends, whatever its direction
+  if (m_gains.find (PathKey (key.second, key.first)) == m_gains.end ())
+    {
+      a.peers.push_back (key.second);
+      if (key.first != key.second)
+        {
+          b.peers.push_back (key.first);
+        }
+    }
+  m_gains[key] = gain;
+  return gain;
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower (double txPowerDbm,
+                                           Ptr<MobilityModel> a,
+                                           Ptr<MobilityModel> b) const
+{
+  NS_ASSERT_MSG (m_model != 0, "No propagation loss model to cache");
+  return txPowerDbm + GetGain (GetNode (a), GetNode (b));
+}
+
+void
+CachedPropagationLossModel::DoCalcRxPowers (Ptr<MobilityModel> a,
+                                            const std::vector<Ptr<MobilityModel> > &receivers,
+                                            std::vector<double> &powerDbm) const
+{
+  NS_ASSERT_MSG (m_model != 0, "No propagation loss model to cache");
+  Node &source = GetNode (a);
+  for (uint32_t i = 0; i < receivers.size (); i++)
+    {
+      powerDbm[i] += GetGain (source, GetNode (receivers[i]));
+    }
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams (int64_t stream)
+{
+  if (m_model == 0)
+    {
+      return 0;
+    }
+  return m_model->AssignStreams (stream);
+}
+
+} // namespace ns3
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CACHED_PROPAGATION_LOSS_MODEL_H
+#define CACHED_PROPAGATION_LOSS_MODEL_H
+
+#include <unordered_map>
+#include <vector>
+#include "propagation-loss-model.h"
+#include "ns3/mobility-model.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup propagation
+ *
+ * \brief Caches the loss computed by another propagation loss model
+ * between nodes which do not move.
+ *
+ * The loss of the wrapped model (Model attribute, including the models
+ * chained to it) is computed once for each ordered pair of mobility models
+ * and kept in a hash table, as long as none of the two models is moving.
+ * The entries of a mobility model are removed when its "CourseChange"
+ * trace source fires; the losses to a moving model (non-zero velocity, or
+ * constant acceleration) are not cached.
+ *
+ * The wrapped model must be deterministic and its loss must not depend on
+ * the transmission power: random, fading and fixed RSS models must be
+ * chained after the cache (with SetNext) rather than wrapped by it.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  CachedPropagationLossModel ();
+  virtual ~CachedPropagationLossModel ();
+
+  /**
+   * \param model the propagation loss model whose loss is cached
+   */
+  void SetModel (Ptr<PropagationLossModel> model);
+  /**
+   * \return the propagation loss model whose loss is cached
+   */
+  Ptr<PropagationLossModel> GetModel (void) const;
+
+  /**
+   * Remove all the cached losses.
+   */
+  void Clear (void);
+  /**
+   * \return the number of cached losses
+   */
+  uint32_t GetNCachedPaths (void) const;
+
+private:
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   */
+  CachedPropagationLossModel (const CachedPropagationLossModel &);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   * \returns
+   */
+  CachedPropagationLossModel & operator = (const CachedPropagationLossModel &);
+
+  virtual void DoDispose (void);
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (Ptr<MobilityModel> a,
+                               const std::vector<Ptr<MobilityModel> > &receivers,
+                               std::vector<double> &powerDbm) const;
+  virtual int64_t DoAssignStreams (int64_t stream);
+
+  /// A mobility model seen by the cache
+  struct Node
+  {
+    Ptr<MobilityModel> mobility;              //!< the mobility model
+    bool isStatic;                            //!< whether its losses can be cached
+    std::vector<const MobilityModel *> peers; //!< other ends of its cached paths
+  };
+  /// A path, from the first to the second mobility model
+  typedef std::pair<const MobilityModel *, const MobilityModel *> PathKey;
+  /// Hash function of a path
+  struct PathKeyHash
+  {
+    /**
+     * \param key the path
+     * \returns the hash of the path
+     */
+    std::size_t operator () (const PathKey &key) const;
+  };
+
+  /**
+   * Return the node of a mobility model, following its course changes
+   * if it is seen for the first time.
+   *
+   * \param mobility the mobility model
+   * \returns the node
+   */
+  Node & GetNode (Ptr<MobilityModel> mobility) const;
+  /**
+   * \param a the node of the source
+   * \param b the node of the destination
+   * \returns the gain (in dB) of the path from a to b
+   */
+  double GetGain (Node &a, Node &b) const;
+  /**
+   * Trace sink for the CourseChange trace source of the mobility models:
+   * removes the cached losses of the model.
+   *
+   * \param mobility the mobility model whose course changed
+   */
+  void CourseChanged (Ptr<const MobilityModel> mobility);
+
+  Ptr<PropagationLossModel> m_model; //!< the wrapped model
+  /// Mobility models seen by the cache
+  mutable std::unordered_map<const MobilityModel *, Node> m_nodes;
+  /// Gain (dB) of the cached paths
+  mutable std::unordered_map<PathKey, double, PathKeyHash> m_gains;
+};
+
+} // namespace ns3
+
+#endif /* CACHED_PROPAGATION_LOSS_MODEL_H */
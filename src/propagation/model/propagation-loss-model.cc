@@ -82,6 +82,30 @@ PropagationLossModel::CalcRxPower (double txPowerDbm,
   return self;
 }
 
+void
+PropagationLossModel::CalcRxPowers (double txPowerDbm,
+                                    Ptr<MobilityModel> a,
+                                    const std::vector<Ptr<MobilityModel> > &receivers,
+                                    std::vector<double> &rxPowerDbm) const
+{
+  rxPowerDbm.assign (receivers.size (), txPowerDbm);
+  for (const PropagationLossModel *model = this; model != 0; model = PeekPointer (model->m_next))
+    {
+      model->DoCalcRxPowers (a, receivers, rxPowerDbm);
+    }
+}
+
+void
+PropagationLossModel::DoCalcRxPowers (Ptr<MobilityModel> a,
+                                      const std::vector<Ptr<MobilityModel> > &receivers,
+                                      std::vector<double> &powerDbm) const
+{
+  for (uint32_t i = 0; i < receivers.size (); i++)
+    {
+      powerDbm[i] = DoCalcRxPower (powerDbm[i], a, receivers[i]);
+    }
+}
+
 int64_t
 PropagationLossModel::AssignStreams (int64_t stream)
 {
@@ -28,6 +28,7 @@
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
 #include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -93,6 +94,22 @@ public:
                       Ptr<MobilityModel> a,
                       Ptr<MobilityModel> b) const;
 
+  /**
+   * Returns the Rx Power at several destinations of a transmission, taking
+   * into account all the PropagationLossModel(s) chained to the current
+   * one. This is equivalent to calling CalcRxPower for each destination,
+   * but lets the models share work between the destinations.
+   *
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param a the mobility model of the source
+   * \param receivers the mobility models of the destinations
+   * \param rxPowerDbm the reception power at each destination (in dBm)
+   */
+  void CalcRxPowers (double txPowerDbm,
+                     Ptr<MobilityModel> a,
+                     const std::vector<Ptr<MobilityModel> > &receivers,
+                     std::vector<double> &rxPowerDbm) const;
+
   /**
    * If this loss model uses objects of type RandomVariableStream,
    * set the stream numbers to the integers starting with the offset
@@ -134,6 +151,20 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const = 0;
 
+  /**
+   * Applies only the particular PropagationLossModel to the power received
+   * by several destinations. The default implementation calls
+   * DoCalcRxPower for each destination.
+   *
+   * \param a the mobility model of the source
+   * \param receivers the mobility models of the destinations
+   * \param powerDbm the power at each destination before this model, replaced
+   *        by the power after this model (in dBm)
+   */
+  virtual void DoCalcRxPowers (Ptr<MobilityModel> a,
+                               const std::vector<Ptr<MobilityModel> > &receivers,
+                               std::vector<double> &powerDbm) const;
+
   /**
    * Subclasses must implement this; those not using random variables
    * can return zero
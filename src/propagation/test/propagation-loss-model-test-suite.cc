@@ -22,7 +22,11 @@
 #include "ns3/config.h"
 #include "ns3/double.h"
 #include "ns3/propagation-loss-model.h"
+#include "ns3/cached-propagation-loss-model.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/waypoint-mobility-model.h"
+#include "ns3/boolean.h"
 #include "ns3/simulator.h"
 
 using namespace ns3;
@@ -436,6 +440,123 @@ RangePropagationLossModelTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class CachedPropagationLossModelTestCase : public TestCase
+{
+public:
+  CachedPropagationLossModelTestCase ();
+  virtual ~CachedPropagationLossModelTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Compare the cached losses, one by one and in a batch, with the
+   * losses of the wrapped model.
+   */
+  void Check (void);
+
+  std::vector<Ptr<MobilityModel> > m_nodes;       //!< mobility of the nodes
+  Ptr<PropagationLossModel> m_reference;          //!< the wrapped model
+  Ptr<PropagationLossModel> m_next;               //!< the model chained to the cache
+  Ptr<CachedPropagationLossModel> m_cached;       //!< the cache under test
+};
+
+CachedPropagationLossModelTestCase::CachedPropagationLossModelTestCase ()
+  : TestCase ("Test CachedPropagationLossModel")
+{
+}
+
+CachedPropagationLossModelTestCase::~CachedPropagationLossModelTestCase ()
+{
+}
+
+void
+CachedPropagationLossModelTestCase::Check (void)
+{
+  double txPowerDbm = 16.0;
+  double tolerance = 1e-9;
+  std::vector<double> rxPowerDbm;
+  for (uint32_t i = 0; i < m_nodes.size (); i++)
+    {
+      m_cached->CalcRxPowers (txPowerDbm, m_nodes[i], m_nodes, rxPowerDbm);
+      NS_TEST_ASSERT_MSG_EQ (rxPowerDbm.size (), m_nodes.size (), "Wrong number of powers");
+      for (uint32_t j = 0; j < m_nodes.size (); j++)
+        {
+          if (i == j)
+            {
+              continue;
+            }
+          double expected = m_next->CalcRxPower (m_reference->CalcRxPower (txPowerDbm, m_nodes[i], m_nodes[j]),
+                                                 m_nodes[i], m_nodes[j]);
+          NS_TEST_ASSERT_MSG_EQ_TOL (m_cached->CalcRxPower (txPowerDbm, m_nodes[i], m_nodes[j]), expected, tolerance,
+                                     "Wrong cached power from " << i << " to " << j << " at " << Simulator::Now ().GetSeconds ());
+          NS_TEST_ASSERT_MSG_EQ_TOL (rxPowerDbm[j], expected, tolerance,
+                                     "Wrong batch power from " << i << " to " << j << " at " << Simulator::Now ().GetSeconds ());
+        }
+    }
+}
+
+void
+CachedPropagationLossModelTestCase::DoRun (void)
+{
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      Ptr<MobilityModel> node = CreateObject<ConstantPositionMobilityModel> ();
+      node->SetPosition (Vector (10.0 * i, 3.0 * i * i, 1.5));
+      m_nodes.push_back (node);
+    }
+  Ptr<ConstantVelocityMobilityModel> mover = CreateObject<ConstantVelocityMobilityModel> ();
+  mover->SetPosition (Vector (-20, 5, 1.5));
+  m_nodes.push_back (mover);
+  // a lazy node is paused at first, then moves without a course change
+  Ptr<WaypointMobilityModel> lazy = CreateObject<WaypointMobilityModel> ();
+  lazy->SetAttribute ("LazyNotify", BooleanValue (true));
+  lazy->AddWaypoint (Waypoint (Seconds (0), Vector (30, -10, 1.5)));
+  lazy->AddWaypoint (Waypoint (Seconds (20), Vector (30, -10, 1.5)));
+  lazy->AddWaypoint (Waypoint (Seconds (40), Vector (90, 50, 1.5)));
+  m_nodes.push_back (lazy);
+
+  m_reference = CreateObject<LogDistancePropagationLossModel> ();
+  Ptr<TwoRayGroundPropagationLossModel> next = CreateObject<TwoRayGroundPropagationLossModel> ();
+  m_reference->SetNext (next);
+  m_cached = CreateObject<CachedPropagationLossModel> ();
+  m_cached->SetModel (m_reference);
+  // the models chained to the cache are not cached
+  Ptr<MatrixPropagationLossModel> matrix = CreateObject<MatrixPropagationLossModel> ();
+  matrix->SetDefaultLoss (0);
+  matrix->SetLoss (m_nodes[0], m_nodes[1], 7.0, false);
+  m_cached->SetNext (matrix);
+  m_next = matrix;
+
+  // the batches include the path from each node to itself,
+  // the paths of the lazy node are never cached
+  Check ();
+  NS_TEST_ASSERT_MSG_EQ (m_cached->GetNCachedPaths (), 36, "Wrong number of cached paths");
+
+  // a node which moves to another position loses its cached paths
+  m_nodes[2]->SetPosition (Vector (100, 100, 1.5));
+  NS_TEST_ASSERT_MSG_EQ (m_cached->GetNCachedPaths (), 25, "The paths of a moved node are still cached");
+  Check ();
+
+  // the paths of a moving node are not cached, and cached again when it stops
+  mover->SetVelocity (Vector (3, 1, 0));
+  NS_TEST_ASSERT_MSG_EQ (m_cached->GetNCachedPaths (), 25, "The paths of a moving node are still cached");
+  Simulator::Schedule (Seconds (5), &CachedPropagationLossModelTestCase::Check, this);
+  Simulator::Schedule (Seconds (10), &CachedPropagationLossModelTestCase::Check, this);
+  Simulator::Schedule (Seconds (11), &ConstantVelocityMobilityModel::SetVelocity, mover, Vector (0, 0, 0));
+  Simulator::Schedule (Seconds (12), &CachedPropagationLossModelTestCase::Check, this);
+  Simulator::Schedule (Seconds (25), &CachedPropagationLossModelTestCase::Check, this);
+  Simulator::Schedule (Seconds (35), &CachedPropagationLossModelTestCase::Check, this);
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (m_cached->GetNCachedPaths (), 36, "Wrong number of cached paths");
+  Simulator::Destroy ();
+
+  m_cached->Dispose ();
+  m_cached = 0;
+  m_reference = 0;
+  m_next = 0;
+  m_nodes.clear ();
+}
+
 class PropagationLossModelsTestSuite : public TestSuite
 {
 public:
@@ -450,6 +571,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite ()
   AddTestCase (new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new MatrixPropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new RangePropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new CachedPropagationLossModelTestCase, TestCase::QUICK);
 }
 
 static PropagationLossModelsTestSuite propagationLossModelsTestSuite;
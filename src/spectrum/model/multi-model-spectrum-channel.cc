@@ -82,6 +82,8 @@ RxSpectrumModelInfo::RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumMod
 
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel ()
+  : m_maxRange (0),
+    m_indexValid (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -95,6 +97,9 @@ MultiModelSpectrumChannel::DoDispose ()
   m_spectrumPropagationLoss = 0;
   m_txSpectrumModelInfoMap.clear ();
   m_rxSpectrumModelInfoMap.clear ();
+  m_index.Clear ();
+  m_indexedPhys.clear ();
+  m_indexValid = false;
   SpectrumChannel::DoDispose ();
 }
 
@@ -119,6 +124,17 @@ MultiModelSpectrumChannel::GetTypeId (void)
                    DoubleValue (1.0e9),
                    MakeDoubleAccessor (&MultiModelSpectrumChannel::m_maxLossDb),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxRange",
+                   "If strictly positive, signals are only propagated to the "
+                   "receivers which are not farther than this distance (in meters) "
+                   "from the transmitter, and the loss models are not evaluated "
+                   "for the others. The receivers are found with a spatial index "
+                   "over their positions. Receivers without a MobilityModel are "
+                   "always considered in range. The default value considers all "
+                   "the receivers.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&MultiModelSpectrumChannel::SetMaxRange),
+                   MakeDoubleChecker<double> (0))
     .AddTraceSource ("PathLoss",
                      "This trace is fired whenever a new path loss value "
                      "is calculated. The first and second parameters "
@@ -140,11 +156,43 @@ MultiModelSpectrumChannel::GetTypeId (void)
 
 
 
+void
+MultiModelSpectrumChannel::SetMaxRange (double maxRange)
+{
+  NS_LOG_FUNCTION (this << maxRange);
+  m_maxRange = maxRange;
+  // the cells of the index are as large as the range
+  m_indexValid = false;
+}
+
+void
+MultiModelSpectrumChannel::BuildIndex (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_index.SetCellSize (m_maxRange);
+  m_indexedPhys.clear ();
+  for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
+       rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
+       ++rxInfoIterator)
+    {
+      for (std::set<Ptr<SpectrumPhy> >::const_iterator phyIt = rxInfoIterator->second.m_rxPhySet.begin ();
+           phyIt != rxInfoIterator->second.m_rxPhySet.end ();
+           ++phyIt)
+        {
+          m_index.Add (m_indexedPhys.size (), (*phyIt)->GetMobility ());
+          m_indexedPhys.push_back (*phyIt);
+        }
+    }
+  m_indexValid = true;
+}
+
 void
 MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
 {
   NS_LOG_FUNCTION (this << phy);
 
+  m_indexValid = false;
+
   Ptr<const SpectrumModel> rxSpectrumModel = phy->GetRxSpectrumModel ();
 
   NS_ASSERT_MSG ((0 != rxSpectrumModel), "phy->GetRxSpectrumModel () returned 0. Please check that the RxSpectrumModel is already set for the phy before calling MultiModelSpectrumChannel::AddRx (phy)");
@@ -272,6 +320,22 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   NS_LOG_LOGIC ("converter map size: " << txInfoIteratorerator->second.m_spectrumConverterMap.size ());
   NS_LOG_LOGIC ("converter map first element: " << txInfoIteratorerator->second.m_spectrumConverterMap.begin ()->first);
 
+  bool culling = m_maxRange > 0 && txMobility;
+  std::set<Ptr<SpectrumPhy> > inRange;
+  if (culling)
+    {
+      if (!m_indexValid)
+        {
+          BuildIndex ();
+        }
+      std::vector<uint32_t> ids;
+      m_index.GetInRange (txMobility->GetPosition (), m_maxRange, ids);
+      for (std::vector<uint32_t>::const_iterator it = ids.begin (); it != ids.end (); ++it)
+        {
+          inRange.insert (m_indexedPhys[*it]);
+        }
+    }
+
   for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
        rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
        ++rxInfoIterator)
@@ -294,18 +358,23 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
         }
 
 
-      for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfoIterator->second.m_rxPhySet.begin ();
-           rxPhyIterator != rxInfoIterator->second.m_rxPhySet.end ();
+      // with a maximum range, only the receivers in range are visited, in
+      // the same order as in the set of receivers of this model
+      const std::set<Ptr<SpectrumPhy> > &rxPhySet = culling ? inRange : rxInfoIterator->second.m_rxPhySet;
+      for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxPhySet.begin ();
+           rxPhyIterator != rxPhySet.end ();
            ++rxPhyIterator)
         {
+          if (culling && rxInfoIterator->second.m_rxPhySet.count (*rxPhyIterator) == 0)
+            {
+              continue;
+            }
           NS_ASSERT_MSG ((*rxPhyIterator)->GetRxSpectrumModel ()->GetUid () == rxSpectrumModelUid,
                          "SpectrumModel change was not notified to MultiModelSpectrumChannel (i.e., AddRx should be called again after model is changed)");
 
           if ((*rxPhyIterator) != txParams->txPhy)
             {
-              NS_LOG_LOGIC (" copying signal parameters " << txParams);
-              Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
-              rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
+              Ptr<SpectrumSignalParameters> rxParams;
               Time delay = MicroSeconds (0);
 
               Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
@@ -313,10 +382,10 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
               if (txMobility && receiverMobility)
                 {
                   double pathLossDb = 0;
-                  if (rxParams->txAntenna != 0)
+                  if (txParams->txAntenna != 0)
                     {
                       Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
-                      double txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
+                      double txAntennaGain = txParams->txAntenna->GetGainDb (txAngles);
                       NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
                       pathLossDb -= txAntennaGain;
                     }
@@ -341,6 +410,10 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                       // beyond range
                       continue;
                     }
+                  // copy the signal only for the receivers in range
+                  NS_LOG_LOGIC (" copying signal parameters " << txParams);
+                  rxParams = txParams->Copy ();
+                  rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
                   double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
                   *(rxParams->psd) *= pathGainLinear;              
 
@@ -354,6 +427,12 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                       delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
                     }
                 }
+              else
+                {
+                  NS_LOG_LOGIC (" copying signal parameters " << txParams);
+                  rxParams = txParams->Copy ();
+                  rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
+                }
 
               Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
               if (netDev)
@@ -27,6 +27,7 @@
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/propagation-delay-model.h>
+#include <ns3/mobility-grid-index.h>
 #include <map>
 #include <set>
 
@@ -158,6 +159,19 @@ private:
    */
   virtual void StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+  /**
+   * Set the maximum distance of the receivers, and invalidate the
+   * spatial index.
+   *
+   * @param maxRange the maximum distance [m], 0 for no limit.
+   */
+  void SetMaxRange (double maxRange);
+
+  /**
+   * Add all the receivers to the spatial index.
+   */
+  void BuildIndex (void);
+
   /**
    * Propagation delay model to be used with this channel.
    */
@@ -201,6 +215,26 @@ private:
    */
   double m_maxLossDb;
 
+  /**
+   * Maximum distance [m] of the receivers, 0 for no limit.
+   */
+  double m_maxRange;
+
+  /**
+   * Positions of the receivers, used if m_maxRange is positive.
+   */
+  MobilityGridIndex m_index;
+
+  /**
+   * The receivers, by their identifier in m_index.
+   */
+  std::vector<Ptr<SpectrumPhy> > m_indexedPhys;
+
+  /**
+   * False if receivers were added since the index was built.
+   */
+  bool m_indexValid;
+
   /**
    * \deprecated The non-const \c Ptr<SpectrumPhy> argument
    * is deprecated and will be changed to \c Ptr<const SpectrumPhy>
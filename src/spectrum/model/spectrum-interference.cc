@@ -63,6 +63,8 @@ SpectrumInterference::DoDispose ()
   m_rxSignal = 0;
   m_allSignals = 0;
   m_noise = 0;
+  m_interf = 0;
+  m_sinr = 0;
   m_errorModel = 0;
   Object::DoDispose ();
 }
@@ -131,10 +133,10 @@ SpectrumInterference::ConditionallyEvaluateChunk ()
   NS_LOG_LOGIC ("if condition: " << condition);
   if (condition)
     {
-      SpectrumValue sinr = (*m_rxSignal) / ((*m_allSignals) - (*m_rxSignal) + (*m_noise));
+      CalculateSinr (*m_rxSignal, *m_allSignals, *m_noise, *m_interf, *m_sinr);
       Time duration = Now () - m_lastChangeTime;
       NS_LOG_LOGIC ("calling m_errorModel->EvaluateChunk (sinr, duration)");
-      m_errorModel->EvaluateChunk (sinr, duration);
+      m_errorModel->EvaluateChunk (*m_sinr, duration);
     }
 }
 
@@ -148,6 +150,8 @@ SpectrumInterference::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noi
   // we'll now create a zeroed SpectrumValue using the same
   // SpectrumModel which is being specified for the noise.
   m_allSignals = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
+  m_interf = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
+  m_sinr = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
 }
 
 void
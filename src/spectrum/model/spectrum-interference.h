@@ -143,6 +143,9 @@ private:
 
   Ptr<const SpectrumValue> m_noise; //!< Noise spectral power density
 
+  Ptr<SpectrumValue> m_interf; //!< Buffer of the interference plus noise of a chunk
+  Ptr<SpectrumValue> m_sinr;   //!< Buffer of the SINR of a chunk
+
   Time m_lastChangeTime;     //!< the time of the last change in m_TotalPower
 
   Ptr<SpectrumErrorModel> m_errorModel; //!< Error model
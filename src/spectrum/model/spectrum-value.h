@@ -497,12 +497,55 @@ public:
    */
   friend double Integral (const SpectrumValue&  arg);
 
+  /**
+   *
+   *
+   * @param x the argument
+   *
+   * @return the L2 norm of the values
+   */
+  friend double Norm (const SpectrumValue& x);
+
+  /**
+   *
+   *
+   * @param x the argument
+   *
+   * @return the sum of the values
+   */
+  friend double Sum (const SpectrumValue& x);
+
   /**
    *
    * @return a Ptr to a copy of this instance
    */
   Ptr<SpectrumValue> Copy () const;
 
+  /**
+   * Add a scaled SpectrumValue to this one (i.e., *this += x * s)
+   * in a single pass, without creating a temporary.
+   *
+   * \param x the SpectrumValue to add
+   * \param s the factor applied to x
+   */
+  void AddScaled (const SpectrumValue& x, double s);
+
+  /**
+   * Compute, in a single pass and without temporaries, the interference
+   * plus noise seen by a signal and the resulting SINR:
+   * interference = allSignals - signal + noise and
+   * sinr = signal / interference.
+   *
+   * \param signal the signal being received
+   * \param allSignals the sum of all the signals, including signal
+   * \param noise the noise
+   * \param interference the interference plus noise (output)
+   * \param sinr the SINR (output)
+   */
+  friend void CalculateSinr (const SpectrumValue& signal, const SpectrumValue& allSignals,
+                             const SpectrumValue& noise, SpectrumValue& interference,
+                             SpectrumValue& sinr);
+
   /**
    *  TracedCallback signature for SpectrumValue.
    *
@@ -619,6 +662,9 @@ SpectrumValue Log10 (const SpectrumValue& arg);
 SpectrumValue Log2 (const SpectrumValue& arg);
 SpectrumValue Log (const SpectrumValue& arg);
 double Integral (const SpectrumValue& arg);
+void CalculateSinr (const SpectrumValue& signal, const SpectrumValue& allSignals,
+                    const SpectrumValue& noise, SpectrumValue& interference,
+                    SpectrumValue& sinr);
 
 
 } // namespace ns3
@@ -242,6 +242,21 @@ SpectrumValueTestSuite::SpectrumValueTestSuite ()
   AddTestCase (new SpectrumValueTestCase (tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"), TestCase::QUICK);
 
 
+  SpectrumValue tv11 (f);
+  tv11 = v1;
+  tv11.AddScaled (v2, 0.25);
+  AddTestCase (new SpectrumValueTestCase (tv11, v1 + v2 * 0.25, "tv11 = v1; tv11.AddScaled (v2, 0.25)"), TestCase::QUICK);
+
+
+  SpectrumValue allSignals = v1 + v2;
+  SpectrumValue noise (f);
+  noise = 0.5;
+  SpectrumValue tinterf (f), tsinr (f);
+  CalculateSinr (v1, allSignals, noise, tinterf, tsinr);
+  AddTestCase (new SpectrumValueTestCase (tinterf, allSignals - v1 + noise, "interference = (v1 + v2) - v1 + noise"), TestCase::QUICK);
+  AddTestCase (new SpectrumValueTestCase (tsinr, v1 / (allSignals - v1 + noise), "sinr = v1 div ((v1 + v2) - v1 + noise)"), TestCase::QUICK);
+
+
 }
 
 
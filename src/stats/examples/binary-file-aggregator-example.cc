@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program records a time series with a BinaryFileAggregator and
+// prints it back as text.  It can also be used to print any file written
+// by a BinaryFileAggregator:
+//
+//   ./waf --run "binary-file-aggregator-example --input=trace.bin"
+//
+
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/stats-module.h"
+
+using namespace ns3;
+
+namespace {
+
+//===========================================================================
+// Function: CreateBinaryFile
+//
+//
+// This function records a sawtooth queue length, one sample every
+// microsecond, through a TimeSeriesAdaptor.
+//===========================================================================
+
+void CreateBinaryFile (const std::string &fileName)
+{
+  Ptr<BinaryFileAggregator> aggregator =
+    CreateObject<BinaryFileAggregator> (fileName);
+  aggregator->AddColumn ("time", BinaryFileAggregator::TIME);
+  aggregator->AddColumn ("bytesInQueue", BinaryFileAggregator::INTEGER);
+
+  // aggregator must be turned on
+  aggregator->Enable ();
+
+  Ptr<TimeSeriesAdaptor> adaptor = CreateObject<TimeSeriesAdaptor> ();
+  adaptor->Enable ();
+  adaptor->TraceConnect ("Output", "bytesInQueue",
+                         MakeCallback (&BinaryFileAggregator::Write2d, aggregator));
+
+  uint32_t bytes = 0;
+  for (uint32_t i = 1; i <= 10000; i++)
+    {
+      uint32_t next = (i % 100) * 1500;
+      Simulator::Schedule (MicroSeconds (i), &TimeSeriesAdaptor::TraceSinkUinteger32,
+                           adaptor, bytes, next);
+      bytes = next;
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // Write the last block to the file.
+  aggregator->Flush ();
+}
+
+//===========================================================================
+// Function: PrintBinaryFile
+//
+//
+// This function prints a binary file as space separated text.
+//===========================================================================
+
+bool PrintBinaryFile (const std::string &fileName)
+{
+  BinaryFileReader reader;
+  if (!reader.Open (fileName))
+    {
+      std::cerr << "Cannot read " << fileName << std::endl;
+      return false;
+    }
+
+  std::cout << "#";
+  for (uint32_t i = 0; i < reader.GetNColumns (); i++)
+    {
+      std::cout << " " << reader.GetColumnName (i);
+    }
+  std::cout << "\n";
+
+  std::vector<double> row;
+  while (reader.ReadRow (row))
+    {
+      for (uint32_t i = 0; i < row.size (); i++)
+        {
+          std::cout << (i ? " " : "") << row[i];
+        }
+      std::cout << "\n";
+    }
+  return true;
+}
+
+}  // unnamed namespace
+
+
+int main (int argc, char *argv[])
+{
+  std::string input;
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "Binary file to print instead of running the example", input);
+  cmd.Parse (argc, argv);
+
+  if (input.empty ())
+    {
+      input = "binary-file-aggregator-example.bin";
+      CreateBinaryFile (input);
+    }
+
+  return PrintBinaryFile (input) ? 0 : 1;
+}
@@ -0,0 +1,504 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#include "binary-file-aggregator.h"
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("BinaryFileAggregator");
+
+NS_OBJECT_ENSURE_REGISTERED (BinaryFileAggregator);
+
+namespace {
+
+/// File magic, followed by a one byte version number.
+const char MAGIC[] = "NS3COLS";
+/// Size of the magic.
+const uint32_t MAGIC_SIZE = 7;
+/// Current file version.
+const uint8_t VERSION = 1;
+/// Nanoseconds in a second, the resolution of TIME columns.
+const double NS_PER_SEC = 1e9;
+
+/**
+ * Append a variable length integer, 7 bits per byte, to a buffer.
+ * \param buf the buffer.
+ * \param v the value.
+ */
+void
+PutVarint (std::vector<uint8_t> &buf, uint64_t v)
+{
+  while (v >= 0x80)
+    {
+      buf.push_back (static_cast<uint8_t> (v) | 0x80);
+      v >>= 7;
+    }
+  buf.push_back (static_cast<uint8_t> (v));
+}
+
+/**
+ * Read a variable length integer from a buffer.
+ * \param buf the buffer.
+ * \param pos the read offset, updated.
+ * \returns the value.
+ */
+uint64_t
+GetVarint (const std::vector<uint8_t> &buf, uint32_t &pos)
+{
+  uint64_t v = 0;
+  for (uint32_t shift = 0; pos < buf.size () && shift < 64; shift += 7)
+    {
+      uint8_t byte = buf[pos++];
+      v |= static_cast<uint64_t> (byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        {
+          break;
+        }
+    }
+  return v;
+}
+
+/**
+ * Read a variable length integer from a stream.
+ * \param is the stream.
+ * \param v the value read.
+ * \returns false if the stream ended.
+ */
+bool
+ReadVarint (std::istream &is, uint64_t &v)
+{
+  v = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+      int byte = is.get ();
+      if (byte == std::char_traits<char>::eof ())
+        {
+          return false;
+        }
+      v |= static_cast<uint64_t> (byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+/**
+ * Append the XOR of two double bit patterns to a buffer.  One byte holds
+ * the number of leading (high nibble) and trailing (low nibble) zero
+ * bytes, followed by the remaining bytes, least significant first.
+ * \param buf the buffer.
+ * \param x the XOR of the bit patterns.
+ */
+void
+PutXor (std::vector<uint8_t> &buf, uint64_t x)
+{
+  if (x == 0)
+    {
+      buf.push_back (0x80);
+      return;
+    }
+  uint8_t lead = 0;
+  while (!(x >> (56 - 8 * lead)))
+    {
+      lead++;
+    }
+  uint8_t trail = 0;
+  while (!((x >> (8 * trail)) & 0xff))
+    {
+      trail++;
+    }
+  buf.push_back (static_cast<uint8_t> (lead << 4 | trail));
+  for (uint8_t i = trail; i < 8 - lead; i++)
+    {
+      buf.push_back (static_cast<uint8_t> (x >> (8 * i)));
+    }
+}
+
+/**
+ * Read the XOR of two double bit patterns from a buffer.
+ * \param buf the buffer.
+ * \param pos the read offset, updated.
+ * \returns the XOR of the bit patterns.
+ */
+uint64_t
+GetXor (const std::vector<uint8_t> &buf, uint32_t &pos)
+{
+  if (pos >= buf.size ())
+    {
+      return 0;
+    }
+  uint8_t header = buf[pos++];
+  uint8_t lead = header >> 4;
+  uint8_t trail = header & 0x0f;
+  uint64_t x = 0;
+  for (uint8_t i = trail; i + lead < 8 && pos < buf.size (); i++)
+    {
+      x |= static_cast<uint64_t> (buf[pos++]) << (8 * i);
+    }
+  return x;
+}
+
+} // anonymous namespace
+
+TypeId
+BinaryFileAggregator::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::BinaryFileAggregator")
+    .SetParent<DataCollectionObject> ()
+    .SetGroupName ("Stats")
+    .AddAttribute ("BlockSize",
+                   "Number of rows accumulated in memory before being "
+                   "written to the file.",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&BinaryFileAggregator::SetBlockSize),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+
+  return tid;
+}
+
+BinaryFileAggregator::BinaryFileAggregator (const std::string &outputFileName)
+  : m_outputFileName (outputFileName),
+    m_blockSize (4096),
+    m_rows (0),
+    m_headerWritten (false)
+{
+  NS_LOG_FUNCTION (this << outputFileName);
+
+  m_file.open (m_outputFileName.c_str (), std::ios::out | std::ios::binary);
+}
+
+BinaryFileAggregator::~BinaryFileAggregator ()
+{
+  NS_LOG_FUNCTION (this);
+  Flush ();
+  m_file.close ();
+}
+
+void
+BinaryFileAggregator::AddColumn (const std::string &name, enum ColumnType type)
+{
+  NS_LOG_FUNCTION (this << name << type);
+  NS_ABORT_MSG_IF (m_headerWritten || m_rows > 0,
+                   "Columns must be added before writing values");
+  Column column;
+  column.name = name;
+  column.type = type;
+  column.last = 0;
+  m_columns.push_back (column);
+}
+
+void
+BinaryFileAggregator::SetBlockSize (uint32_t rows)
+{
+  NS_LOG_FUNCTION (this << rows);
+  NS_ABORT_MSG_IF (rows == 0, "Blocks must contain at least one row");
+  m_blockSize = rows;
+  if (m_rows >= m_blockSize)
+    {
+      Flush ();
+    }
+}
+
+void
+BinaryFileAggregator::WriteHeader (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<uint8_t> header (MAGIC, MAGIC + MAGIC_SIZE);
+  header.push_back (VERSION);
+  PutVarint (header, m_columns.size ());
+  for (std::vector<Column>::const_iterator it = m_columns.begin (); it != m_columns.end (); ++it)
+    {
+      header.push_back (static_cast<uint8_t> (it->type));
+      PutVarint (header, it->name.size ());
+      header.insert (header.end (), it->name.begin (), it->name.end ());
+    }
+  m_file.write (reinterpret_cast<const char *> (&header[0]), header.size ());
+  m_headerWritten = true;
+}
+
+void
+BinaryFileAggregator::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_rows == 0 && m_headerWritten)
+    {
+      return;
+    }
+  if (!m_headerWritten)
+    {
+      WriteHeader ();
+    }
+  if (m_rows == 0)
+    {
+      m_file.flush ();
+      return;
+    }
+
+  std::vector<uint8_t> block;
+  PutVarint (block, m_rows);
+  for (std::vector<Column>::iterator it = m_columns.begin (); it != m_columns.end (); ++it)
+    {
+      PutVarint (block, it->data.size ());
+      block.insert (block.end (), it->data.begin (), it->data.end ());
+      // every block can be decoded on its own
+      it->data.clear ();
+      it->last = 0;
+    }
+  m_file.write (reinterpret_cast<const char *> (&block[0]), block.size ());
+  m_file.flush ();
+  m_rows = 0;
+}
+
+void
+BinaryFileAggregator::WriteRow (const double *values, uint32_t n)
+{
+  NS_LOG_FUNCTION (this << n);
+
+  if (m_columns.empty () && !m_headerWritten)
+    {
+      for (uint32_t i = 0; i < n; i++)
+        {
+          std::ostringstream oss;
+          oss << "v" << i + 1;
+          AddColumn (oss.str (), DOUBLE);
+        }
+    }
+  NS_ABORT_MSG_IF (n != m_columns.size (),
+                   "Wrote " << n << " values to a file with " << m_columns.size () << " columns");
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Column &column = m_columns[i];
+      if (column.type == DOUBLE)
+        {
+          uint64_t bits;
+          std::memcpy (&bits, &values[i], sizeof (bits));
+          PutXor (column.data, bits ^ column.last);
+          column.last = bits;
+        }
+      else
+        {
+          double v = column.type == TIME ? values[i] * NS_PER_SEC : values[i];
+          uint64_t current = static_cast<uint64_t> (static_cast<int64_t> (std::floor (v + 0.5)));
+          int64_t delta = static_cast<int64_t> (current - column.last);
+          // zig-zag encoding, so that small negative deltas stay short
+          PutVarint (column.data, (static_cast<uint64_t> (delta) << 1) ^ static_cast<uint64_t> (delta >> 63));
+          column.last = current;
+        }
+    }
+
+  if (++m_rows >= m_blockSize)
+    {
+      Flush ();
+    }
+}
+
+void
+BinaryFileAggregator::Write1d (std::string context,
+                               double v1)
+{
+  NS_LOG_FUNCTION (this << context << v1);
+
+  if (m_enabled)
+    {
+      WriteRow (&v1, 1);
+    }
+}
+
+void
+BinaryFileAggregator::Write2d (std::string context,
+                               double v1,
+                               double v2)
+{
+  NS_LOG_FUNCTION (this << context << v1 << v2);
+
+  if (m_enabled)
+    {
+      double values[2] = { v1, v2 };
+      WriteRow (values, 2);
+    }
+}
+
+void
+BinaryFileAggregator::Write3d (std::string context,
+                               double v1,
+                               double v2,
+                               double v3)
+{
+  NS_LOG_FUNCTION (this << context << v1 << v2 << v3);
+
+  if (m_enabled)
+    {
+      double values[3] = { v1, v2, v3 };
+      WriteRow (values, 3);
+    }
+}
+
+
+BinaryFileReader::BinaryFileReader ()
+  : m_rowsLeft (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+bool
+BinaryFileReader::Open (const std::string &fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+
+  m_columns.clear ();
+  m_rowsLeft = 0;
+  if (m_file.is_open ())
+    {
+      m_file.close ();
+    }
+  m_file.clear ();
+  m_file.open (fileName.c_str (), std::ios::in | std::ios::binary);
+
+  char magic[MAGIC_SIZE + 1];
+  if (!m_file.read (magic, MAGIC_SIZE + 1)
+      || std::memcmp (magic, MAGIC, MAGIC_SIZE) != 0
+      || static_cast<uint8_t> (magic[MAGIC_SIZE]) != VERSION)
+    {
+      NS_LOG_WARN ("Not a binary aggregator file: " << fileName);
+      return false;
+    }
+
+  uint64_t nColumns;
+  if (!ReadVarint (m_file, nColumns))
+    {
+      return false;
+    }
+  for (uint64_t i = 0; i < nColumns; i++)
+    {
+      Column column;
+      int type = m_file.get ();
+      uint64_t length;
+      if (type > BinaryFileAggregator::TIME || type < 0 || !ReadVarint (m_file, length))
+        {
+          return false;
+        }
+      column.type = static_cast<BinaryFileAggregator::ColumnType> (type);
+      column.name.resize (length);
+      if (length > 0 && !m_file.read (&column.name[0], length))
+        {
+          return false;
+        }
+      column.pos = 0;
+      column.last = 0;
+      m_columns.push_back (column);
+    }
+  return true;
+}
+
+uint32_t
+BinaryFileReader::GetNColumns (void) const
+{
+  return m_columns.size ();
+}
+
+std::string
+BinaryFileReader::GetColumnName (uint32_t i) const
+{
+  NS_ASSERT (i < m_columns.size ());
+  return m_columns[i].name;
+}
+
+enum BinaryFileAggregator::ColumnType
+BinaryFileReader::GetColumnType (uint32_t i) const
+{
+  NS_ASSERT (i < m_columns.size ());
+  return m_columns[i].type;
+}
+
+bool
+BinaryFileReader::ReadBlock (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint64_t rows;
+  if (!ReadVarint (m_file, rows))
+    {
+      return false;
+    }
+  for (std::vector<Column>::iterator it = m_columns.begin (); it != m_columns.end (); ++it)
+    {
+      uint64_t size;
+      if (!ReadVarint (m_file, size))
+        {
+          return false;
+        }
+      it->data.resize (size);
+      if (size > 0 && !m_file.read (reinterpret_cast<char *> (&it->data[0]), size))
+        {
+          return false;
+        }
+      it->pos = 0;
+      it->last = 0;
+    }
+  m_rowsLeft = rows;
+  return true;
+}
+
+bool
+BinaryFileReader::ReadRow (std::vector<double> &row)
+{
+  NS_LOG_FUNCTION (this);
+
+  while (m_rowsLeft == 0)
+    {
+      if (!ReadBlock ())
+        {
+          return false;
+        }
+    }
+
+  row.resize (m_columns.size ());
+  for (uint32_t i = 0; i < m_columns.size (); i++)
+    {
+      Column &column = m_columns[i];
+      if (column.type == BinaryFileAggregator::DOUBLE)
+        {
+          column.last ^= GetXor (column.data, column.pos);
+          std::memcpy (&row[i], &column.last, sizeof (row[i]));
+        }
+      else
+        {
+          uint64_t zigzag = GetVarint (column.data, column.pos);
+          uint64_t delta = (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+          column.last += delta;
+          row[i] = static_cast<double> (static_cast<int64_t> (column.last));
+          if (column.type == BinaryFileAggregator::TIME)
+            {
+              row[i] /= NS_PER_SEC;
+            }
+        }
+    }
+  m_rowsLeft--;
+  return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/binary-file-aggregator.h"
+#include "ns3/time-series-adaptor.h"
+#include "ns3/simulator.h"
+#include "ns3/callback.h"
+
+using namespace ns3;
+
+// ===========================================================================
+// Test case for writing and reading back typed columns.
+// ===========================================================================
+
+class BinaryFileAggregatorTestCase : public TestCase
+{
+public:
+  BinaryFileAggregatorTestCase ();
+  virtual ~BinaryFileAggregatorTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+BinaryFileAggregatorTestCase::BinaryFileAggregatorTestCase ()
+  : TestCase ("Binary file aggregator round trip")
+{
+}
+
+BinaryFileAggregatorTestCase::~BinaryFileAggregatorTestCase ()
+{
+}
+
+void
+BinaryFileAggregatorTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("binary-file-aggregator.bin");
+  const uint32_t nRows = 1005;
+
+  Ptr<BinaryFileAggregator> aggregator = CreateObject<BinaryFileAggregator> (fileName);
+  aggregator->AddColumn ("time", BinaryFileAggregator::TIME);
+  aggregator->AddColumn ("queue", BinaryFileAggregator::INTEGER);
+  aggregator->AddColumn ("ratio", BinaryFileAggregator::DOUBLE);
+  aggregator->SetBlockSize (100);
+  aggregator->Enable ();
+
+  for (uint32_t i = 0; i < nRows; i++)
+    {
+      double queue = (i % 50 < 25) ? i % 50 : 50 - i % 50;
+      aggregator->Write3d ("context", i * 1e-6, queue - 10, std::sin (i * 0.01));
+    }
+  aggregator->Disable ();
+  aggregator->Write3d ("context", 0, 0, 0);
+  aggregator = 0;
+
+  BinaryFileReader reader;
+  NS_TEST_ASSERT_MSG_EQ (reader.Open (fileName), true, "Cannot open the file");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetNColumns (), 3, "Unexpected number of columns");
+  NS_TEST_EXPECT_MSG_EQ (reader.GetColumnName (1), "queue", "Unexpected column name");
+  NS_TEST_EXPECT_MSG_EQ (reader.GetColumnType (0), BinaryFileAggregator::TIME, "Unexpected column type");
+
+  std::vector<double> row;
+  uint32_t i = 0;
+  while (reader.ReadRow (row))
+    {
+      double queue = (i % 50 < 25) ? i % 50 : 50 - i % 50;
+      NS_TEST_ASSERT_MSG_EQ_TOL (row[0], i * 1e-6, 1e-12, "Wrong time at row " << i);
+      NS_TEST_ASSERT_MSG_EQ (row[1], queue - 10, "Wrong integer at row " << i);
+      NS_TEST_ASSERT_MSG_EQ (row[2], std::sin (i * 0.01), "Wrong double at row " << i);
+      i++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (i, nRows, "Unexpected number of rows");
+}
+
+// ===========================================================================
+// Test case for recording a TimeSeriesAdaptor with default columns.
+// ===========================================================================
+
+class BinaryFileAggregatorAdaptorTestCase : public TestCase
+{
+public:
+  BinaryFileAggregatorAdaptorTestCase ();
+  virtual ~BinaryFileAggregatorAdaptorTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+BinaryFileAggregatorAdaptorTestCase::BinaryFileAggregatorAdaptorTestCase ()
+  : TestCase ("Binary file aggregator fed by a time series adaptor")
+{
+}
+
+BinaryFileAggregatorAdaptorTestCase::~BinaryFileAggregatorAdaptorTestCase ()
+{
+}
+
+void
+BinaryFileAggregatorAdaptorTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("binary-file-adaptor.bin");
+
+  Ptr<BinaryFileAggregator> aggregator = CreateObject<BinaryFileAggregator> (fileName);
+  aggregator->Enable ();
+  Ptr<TimeSeriesAdaptor> adaptor = CreateObject<TimeSeriesAdaptor> ();
+  adaptor->Enable ();
+  adaptor->TraceConnect ("Output", "queue",
+                         MakeCallback (&BinaryFileAggregator::Write2d, aggregator));
+
+  for (uint32_t i = 1; i <= 20; i++)
+    {
+      Simulator::Schedule (MilliSeconds (i), &TimeSeriesAdaptor::TraceSinkUinteger32,
+                           adaptor, i - 1, i);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+  aggregator->Flush ();
+
+  BinaryFileReader reader;
+  NS_TEST_ASSERT_MSG_EQ (reader.Open (fileName), true, "Cannot open the file");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetNColumns (), 2, "Unexpected number of columns");
+  NS_TEST_EXPECT_MSG_EQ (reader.GetColumnName (0), "v1", "Unexpected default column name");
+
+  std::vector<double> row;
+  uint32_t i = 0;
+  while (reader.ReadRow (row))
+    {
+      i++;
+      NS_TEST_ASSERT_MSG_EQ_TOL (row[0], i * 1e-3, 1e-12, "Wrong time at row " << i);
+      NS_TEST_ASSERT_MSG_EQ (row[1], i, "Wrong value at row " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (i, 20, "Unexpected number of rows");
+}
+
+class BinaryFileAggregatorTestSuite : public TestSuite
+{
+public:
+  BinaryFileAggregatorTestSuite ();
+};
+
+BinaryFileAggregatorTestSuite::BinaryFileAggregatorTestSuite ()
+  : TestSuite ("binary-file-aggregator", UNIT)
+{
+  AddTestCase (new BinaryFileAggregatorTestCase, TestCase::QUICK);
+  AddTestCase (new BinaryFileAggregatorAdaptorTestCase, TestCase::QUICK);
+}
+
+static BinaryFileAggregatorTestSuite binaryFileAggregatorTestSuite;
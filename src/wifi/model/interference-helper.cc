@@ -104,28 +104,28 @@ InterferenceHelper::Event::GetPreambleType (void) const
  *       short period of time.
  ****************************************************************/
 
-InterferenceHelper::NiChange::NiChange (Time time, double delta)
-  : m_time (time),
-    m_delta (delta)
+InterferenceHelper::NiChange::NiChange (double power, Ptr<InterferenceHelper::Event> event)
+  : m_power (power),
+    m_event (event)
 {
 }
 
-Time
-InterferenceHelper::NiChange::GetTime (void) const
+double
+InterferenceHelper::NiChange::GetPower (void) const
 {
-  return m_time;
+  return m_power;
 }
 
-double
-InterferenceHelper::NiChange::GetDelta (void) const
+void
+InterferenceHelper::NiChange::AddPower (double power)
 {
-  return m_delta;
+  m_power += power;
 }
 
-bool
-InterferenceHelper::NiChange::operator < (const InterferenceHelper::NiChange& o) const
+Ptr<InterferenceHelper::Event>
+InterferenceHelper::NiChange::GetEvent (void) const
 {
-  return (m_time < o.m_time);
+  return m_event;
 }
 
 
@@ -135,9 +135,10 @@ InterferenceHelper::NiChange::operator < (const InterferenceHelper::NiChange& o)
 
 InterferenceHelper::InterferenceHelper ()
   : m_errorRateModel (0),
-    m_firstPower (0.0),
     m_rxing (false)
 {
+  // the power level before any signal
+  m_niChanges.insert (std::make_pair (Seconds (0), NiChange (0.0, 0)));
 }
 
 InterferenceHelper::~InterferenceHelper ()
@@ -199,18 +200,11 @@ Time
 InterferenceHelper::GetEnergyDuration (double energyW)
 {
   Time now = Simulator::Now ();
-  double noiseInterferenceW = 0.0;
   Time end = now;
-  noiseInterferenceW = m_firstPower;
-  for (NiChanges::const_iterator i = m_niChanges.begin (); i != m_niChanges.end (); i++)
+  for (NiChanges::const_iterator i = m_niChanges.lower_bound (now); i != m_niChanges.end (); i++)
     {
-      noiseInterferenceW += i->GetDelta ();
-      end = i->GetTime ();
-      if (end < now)
-        {
-          continue;
-        }
-      if (noiseInterferenceW < energyW)
+      end = i->first;
+      if (i->second.GetPower () < energyW)
         {
           break;
         }
@@ -221,23 +215,13 @@ InterferenceHelper::GetEnergyDuration (double energyW)
 void
 InterferenceHelper::AppendEvent (Ptr<InterferenceHelper::Event> event)
 {
-  Time now = Simulator::Now ();
+  NS_LOG_FUNCTION (this);
   if (!m_rxing)
     {
-      NiChanges::iterator nowIterator = GetPosition (now);
-      for (NiChanges::iterator i = m_niChanges.begin (); i != nowIterator; i++)
-        {
-          m_firstPower += i->GetDelta ();
-        }
-      m_niChanges.erase (m_niChanges.begin (), nowIterator);
-      m_niChanges.insert (m_niChanges.begin (), NiChange (event->GetStartTime (), event->GetRxPowerW ()));
+      // no reception in progress: only the current power level is needed
+      EraseNiChangesBefore (Simulator::Now ());
     }
-  else
-    {
-      AddNiChangeEvent (NiChange (event->GetStartTime (), event->GetRxPowerW ()));
-    }
-  AddNiChangeEvent (NiChange (event->GetEndTime (), -event->GetRxPowerW ()));
-
+  AddNiChangeEvent (event);
 }
 
 
@@ -259,18 +243,25 @@ InterferenceHelper::CalculateSnr (double signal, double noiseInterference, uint3
 double
 InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event> event, NiChanges *ni) const
 {
-  double noiseInterference = m_firstPower;
   NS_ASSERT (m_rxing);
-  for (NiChanges::const_iterator i = m_niChanges.begin () + 1; i != m_niChanges.end (); i++)
+  // the changes at the same time are in insertion order: start from the first one
+  NiChanges::const_iterator it = m_niChanges.lower_bound (event->GetStartTime ());
+  while (it != m_niChanges.end () && it->second.GetEvent () != event)
     {
-      if ((event->GetEndTime () == i->GetTime ()) && event->GetRxPowerW () == -i->GetDelta ())
-        {
-          break;
-        }
-      ni->push_back (*i);
+      it++;
     }
-  ni->insert (ni->begin (), NiChange (event->GetStartTime (), noiseInterference));
-  ni->push_back (NiChange (event->GetEndTime (), 0));
+  NS_ASSERT_MSG (it != m_niChanges.end () && it != m_niChanges.begin (), "Event not found");
+  NiChanges::const_iterator previous = it;
+  previous--;
+  double noiseInterference = previous->second.GetPower ();
+  double powerW = event->GetRxPowerW ();
+  ni->insert (ni->end (), std::make_pair (event->GetStartTime (), NiChange (noiseInterference, event)));
+  // only the changes overlapping the event are visited
+  for (it++; it != m_niChanges.end () && it->second.GetEvent () != event; it++)
+    {
+      ni->insert (ni->end (), std::make_pair (it->first, NiChange (it->second.GetPower () - powerW, it->second.GetEvent ())));
+    }
+  ni->insert (ni->end (), std::make_pair (event->GetEndTime (), NiChange (0, event)));
   return noiseInterference;
 }
 
@@ -293,19 +284,19 @@ InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const InterferenceHelper::Event
   NS_LOG_FUNCTION (this);
   double psr = 1.0; /* Packet Success Rate */
   NiChanges::iterator j = ni->begin ();
-  Time previous = (*j).GetTime ();
+  Time previous = j->first;
   WifiMode payloadMode = event->GetPayloadMode ();
   WifiPreamble preamble = event->GetPreambleType ();
-  Time plcpHeaderStart = (*j).GetTime () + WifiPhy::GetPlcpPreambleDuration (event->GetTxVector (), preamble); //packet start time + preamble
+  Time plcpHeaderStart = j->first + WifiPhy::GetPlcpPreambleDuration (event->GetTxVector (), preamble); //packet start time + preamble
   Time plcpHsigHeaderStart = plcpHeaderStart + WifiPhy::GetPlcpHeaderDuration (event->GetTxVector (), preamble); //packet start time + preamble + L-SIG
   Time plcpHtTrainingSymbolsStart = plcpHsigHeaderStart + WifiPhy::GetPlcpHtSigHeaderDuration (preamble) + WifiPhy::GetPlcpVhtSigA1Duration (preamble) + WifiPhy::GetPlcpVhtSigA2Duration (preamble); //packet start time + preamble + L-SIG + HT-SIG or VHT-SIG-A (A1 + A2)
   Time plcpPayloadStart = plcpHtTrainingSymbolsStart + WifiPhy::GetPlcpHtTrainingSymbolDuration (preamble, event->GetTxVector ()) + WifiPhy::GetPlcpVhtSigBDuration (preamble); //packet start time + preamble + L-SIG + HT-SIG or VHT-SIG-A (A1 + A2) + (V)HT Training + VHT-SIG-B
-  double noiseInterferenceW = (*j).GetDelta ();
+  double noiseInterferenceW = j->second.GetPower ();
   double powerW = event->GetRxPowerW ();
   j++;
   while (ni->end () != j)
     {
-      Time current = (*j).GetTime ();
+      Time current = j->first;
       NS_LOG_DEBUG ("previous= " << previous << ", current=" << current);
       NS_ASSERT (current >= previous);
       //Case 1: Both previous and current point to the payload
@@ -330,8 +321,8 @@ InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const InterferenceHelper::Event
           NS_LOG_DEBUG ("previous is before payload and current is in the payload: mode=" << payloadMode << ", psr=" << psr);
         }
 
-      noiseInterferenceW += (*j).GetDelta ();
-      previous = (*j).GetTime ();
+      noiseInterferenceW = j->second.GetPower ();
+      previous = j->first;
       j++;
     }
 
@@ -345,7 +336,7 @@ InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const InterferenceHelper::Event>
   NS_LOG_FUNCTION (this);
   double psr = 1.0; /* Packet Success Rate */
   NiChanges::iterator j = ni->begin ();
-  Time previous = (*j).GetTime ();
+  Time previous = j->first;
   WifiMode payloadMode = event->GetPayloadMode ();
   WifiPreamble preamble = event->GetPreambleType ();
   WifiMode htHeaderMode;
@@ -360,16 +351,16 @@ InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const InterferenceHelper::Event>
       htHeaderMode = WifiPhy::GetVhtPlcpHeaderMode (payloadMode);
     }
   WifiMode headerMode = WifiPhy::GetPlcpHeaderMode (payloadMode, preamble, event->GetTxVector ());
-  Time plcpHeaderStart = (*j).GetTime () + WifiPhy::GetPlcpPreambleDuration (event->GetTxVector (), preamble); //packet start time + preamble
+  Time plcpHeaderStart = j->first + WifiPhy::GetPlcpPreambleDuration (event->GetTxVector (), preamble); //packet start time + preamble
   Time plcpHsigHeaderStart = plcpHeaderStart + WifiPhy::GetPlcpHeaderDuration (event->GetTxVector (), preamble); //packet start time + preamble + L-SIG
   Time plcpHtTrainingSymbolsStart = plcpHsigHeaderStart + WifiPhy::GetPlcpHtSigHeaderDuration (preamble) + WifiPhy::GetPlcpVhtSigA1Duration (preamble) + WifiPhy::GetPlcpVhtSigA2Duration (preamble); //packet start time + preamble + L-SIG + HT-SIG or VHT-SIG-A (A1 + A2)
   Time plcpPayloadStart = plcpHtTrainingSymbolsStart + WifiPhy::GetPlcpHtTrainingSymbolDuration (preamble, event->GetTxVector ()) + WifiPhy::GetPlcpVhtSigBDuration (preamble); //packet start time + preamble + L-SIG + HT-SIG or VHT-SIG-A (A1 + A2) + (V)HT Training + VHT-SIG-B
-  double noiseInterferenceW = (*j).GetDelta ();
+  double noiseInterferenceW = j->second.GetPower ();
   double powerW = event->GetRxPowerW ();
   j++;
   while (ni->end () != j)
     {
-      Time current = (*j).GetTime ();
+      Time current = j->first;
       NS_LOG_DEBUG ("previous= " << previous << ", current=" << current);
       NS_ASSERT (current >= previous);
       //Case 1: previous and current after playload start: nothing to do
@@ -784,8 +775,8 @@ InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const InterferenceHelper::Event>
             }
         }
 
-      noiseInterferenceW += (*j).GetDelta ();
-      previous = (*j).GetTime ();
+      noiseInterferenceW = j->second.GetPower ();
+      previous = j->first;
       j++;
     }
 
@@ -838,19 +829,48 @@ InterferenceHelper::EraseEvents (void)
 {
   m_niChanges.clear ();
   m_rxing = false;
-  m_firstPower = 0.0;
+  // the power level before any signal
+  m_niChanges.insert (std::make_pair (Seconds (0), NiChange (0.0, 0)));
 }
 
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::GetPosition (Time moment)
 {
-  return std::upper_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (moment, 0));
+  return m_niChanges.upper_bound (moment);
+}
+
+void
+InterferenceHelper::AddNiChangeEvent (Ptr<InterferenceHelper::Event> event)
+{
+  double powerW = event->GetRxPowerW ();
+  // changes at the same time are inserted after the existing ones
+  NiChanges::iterator next = GetPosition (event->GetStartTime ());
+  NS_ASSERT (next != m_niChanges.begin ());
+  NiChanges::iterator previous = next;
+  previous--;
+  NiChanges::iterator start = m_niChanges.insert (next, std::make_pair (event->GetStartTime (),
+                                                                         NiChange (previous->second.GetPower () + powerW, event)));
+  NiChanges::iterator end = GetPosition (event->GetEndTime ());
+  for (NiChanges::iterator i = ++start; i != end; i++)
+    {
+      i->second.AddPower (powerW);
+    }
+  previous = end;
+  previous--;
+  m_niChanges.insert (end, std::make_pair (event->GetEndTime (), NiChange (previous->second.GetPower () - powerW, event)));
 }
 
 void
-InterferenceHelper::AddNiChangeEvent (NiChange change)
+InterferenceHelper::EraseNiChangesBefore (Time moment)
 {
-  m_niChanges.insert (GetPosition (change.GetTime ()), change);
+  // the changes at moment itself are kept, as an event starting at moment
+  // needs the level before it
+  NiChanges::iterator last = m_niChanges.lower_bound (moment);
+  if (last != m_niChanges.begin ())
+    {
+      last--;
+      m_niChanges.erase (m_niChanges.begin (), last);
+    }
 }
 
 void
@@ -865,6 +885,8 @@ InterferenceHelper::NotifyRxEnd ()
 {
   NS_LOG_FUNCTION (this);
   m_rxing = false;
+  // the changes of the received signal are no longer needed
+  EraseNiChangesBefore (Simulator::Now ());
 }
 
 } //namespace ns3
@@ -24,6 +24,7 @@
 #include <stdint.h>
 #include <vector>
 #include <list>
+#include <map>
 #include "wifi-mode.h"
 #include "wifi-preamble.h"
 #include "wifi-phy-standard.h"
@@ -32,6 +33,8 @@
 #include "ns3/wifi-tx-vector.h"
 #include "error-rate-model.h"
 
+class InterferenceHelperTest;
+
 namespace ns3 {
 
 /**
@@ -222,6 +225,8 @@ private:
 
 
 private:
+  friend class ::InterferenceHelperTest; // To check the trimming of m_niChanges
+
   /**
    * Noise and Interference (thus Ni) event.
    */
@@ -229,41 +234,41 @@ private:
   {
 public:
     /**
-     * Create a NiChange at the given time and the amount of NI change.
+     * Create a NiChange with the given power level and event.
      *
-     * \param time time of the event
-     * \param delta the power
+     * \param power the noise and interference power (W) after this change
+     * \param event the event which caused this change
      */
-    NiChange (Time time, double delta);
+    NiChange (double power, Ptr<Event> event);
     /**
-     * Return the event time.
+     * Return the power
      *
-     * \return the event time.
+     * \return the noise and interference power (W) after this change
      */
-    Time GetTime (void) const;
+    double GetPower (void) const;
     /**
-     * Return the power
+     * Add a signal to the power level
      *
-     * \return the power
+     * \param power the power (W) to add
      */
-    double GetDelta (void) const;
+    void AddPower (double power);
     /**
-     * Compare the event time of two NiChange objects (a < o).
+     * Return the event causing this change
      *
-     * \param o
-     * \return true if a < o.time, false otherwise
+     * \return the event
      */
-    bool operator < (const NiChange& o) const;
+    Ptr<Event> GetEvent (void) const;
 
 
 private:
-    Time m_time;
-    double m_delta;
+    double m_power;
+    Ptr<Event> m_event;
   };
   /**
-   * typedef for a vector of NiChanges
+   * typedef for a time-ordered multimap of NiChanges; changes happening at
+   * the same time are kept in insertion order
    */
-  typedef std::vector <NiChange> NiChanges;
+  typedef std::multimap<Time, NiChange> NiChanges;
   /**
    * typedef for a list of Events
    */
@@ -330,18 +335,29 @@ private:
 
   double m_noiseFigure; /**< noise figure (linear) */
   Ptr<ErrorRateModel> m_errorRateModel;
-  /// Experimental: needed for energy duration calculation
+  /**
+   * Noise and interference power level over time. Only the changes since
+   * the start of the reception in progress, or the last change before now
+   * when there is none, are kept.
+   */
   NiChanges m_niChanges;
-  double m_firstPower;
   bool m_rxing;
   /// Returns an iterator to the first nichange, which is later than moment
   NiChanges::iterator GetPosition (Time moment);
   /**
-   * Add NiChange to the list at the appropriate position.
+   * Add the changes of the power level caused by an event: the power of
+   * the event is added to the level of all the changes during the event.
+   *
+   * \param event
+   */
+  void AddNiChangeEvent (Ptr<Event> event);
+  /**
+   * Remove the changes which happened strictly before moment, except the
+   * last one which holds the power level just before moment.
    *
-   * \param change
+   * \param moment
    */
-  void AddNiChangeEvent (NiChange change);
+  void EraseNiChangesBefore (Time moment);
 };
 
 } //namespace ns3
@@ -0,0 +1,283 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <limits>
+#include "table-error-rate-model.h"
+#include "nist-error-rate-model.h"
+#include "ns3/object-factory.h"
+#include "ns3/double.h"
+#include "ns3/string.h"
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TableErrorRateModel");
+
+NS_OBJECT_ENSURE_REGISTERED (TableErrorRateModel);
+
+/// bounds of the tabulated log (-log (1 - p)), far enough that the chunk
+/// success rate is 1 (resp. 0) for any number of bits
+static const double TABLE_MIN_VALUE = -700.0;
+static const double TABLE_MAX_VALUE = std::log (50.0);
+
+TypeId
+TableErrorRateModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TableErrorRateModel")
+    .SetParent<ErrorRateModel> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<TableErrorRateModel> ()
+    .AddAttribute ("BaseModel",
+                   "The type of the error rate model which is interpolated.",
+                   TypeIdValue (NistErrorRateModel::GetTypeId ()),
+                   MakeTypeIdAccessor (&TableErrorRateModel::m_baseModelType),
+                   MakeTypeIdChecker ())
+    .AddAttribute ("MinSnr",
+                   "The smallest SNR (dB) of the tables.",
+                   DoubleValue (-10.0),
+                   MakeDoubleAccessor (&TableErrorRateModel::m_minSnrDb),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxSnr",
+                   "The largest SNR (dB) of the tables.",
+                   DoubleValue (60.0),
+                   MakeDoubleAccessor (&TableErrorRateModel::m_maxSnrDb),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("Step",
+                   "The SNR step (dB) of the tables.",
+                   DoubleValue (0.05),
+                   MakeDoubleAccessor (&TableErrorRateModel::m_stepDb),
+                   MakeDoubleChecker<double> (1e-6))
+    .AddAttribute ("Tolerance",
+                   "The largest difference between the interpolated chunk success rate "
+                   "and the one of the base model, checked in the middle of each step.",
+                   DoubleValue (1e-3),
+                   MakeDoubleAccessor (&TableErrorRateModel::m_tolerance),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("CacheFile",
+                   "The file where the tables are kept between simulation runs. "
+                   "No file is used if empty.",
+                   StringValue (""),
+                   MakeStringAccessor (&TableErrorRateModel::m_cacheFile),
+                   MakeStringChecker ())
+  ;
+  return tid;
+}
+
+TableErrorRateModel::TableErrorRateModel ()
+  : m_nPoints (0),
+    m_cacheRead (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TableErrorRateModel::~TableErrorRateModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+TableErrorRateModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_baseModel = 0;
+  m_index.clear ();
+  m_tables.clear ();
+  ErrorRateModel::DoDispose ();
+}
+
+void
+TableErrorRateModel::SetBaseModel (Ptr<ErrorRateModel> model)
+{
+  NS_LOG_FUNCTION (this << model);
+  m_baseModel = model;
+  m_baseModelType = model->GetInstanceTypeId ();
+  m_index.clear ();
+  m_tables.clear ();
+  m_cacheRead = false;
+}
+
+Ptr<ErrorRateModel>
+TableErrorRateModel::GetBaseModel (void) const
+{
+  if (m_baseModel == 0)
+    {
+      ObjectFactory factory;
+      factory.SetTypeId (m_baseModelType);
+      m_baseModel = factory.Create<ErrorRateModel> ();
+    }
+  return m_baseModel;
+}
+
+std::string
+TableErrorRateModel::GetCacheHeader (void) const
+{
+  std::ostringstream oss;
+  oss << "ns3::TableErrorRateModel 1 " << m_baseModelType.GetName ()
+      << " " << m_minSnrDb << " " << m_stepDb << " " << m_nPoints << " " << m_tolerance;
+  return oss.str ();
+}
+
+void
+TableErrorRateModel::ReadCache (void) const
+{
+  NS_LOG_FUNCTION (this);
+  m_cacheRead = true;
+  if (m_cacheFile.empty ())
+    {
+      return;
+    }
+  std::ifstream is (m_cacheFile.c_str (), std::ios::binary);
+  std::string header;
+  if (!std::getline (is, header) || header != GetCacheHeader ())
+    {
+      NS_LOG_DEBUG ("No matching tables in " << m_cacheFile);
+      return;
+    }
+  std::string name;
+  while (std::getline (is, name))
+    {
+      std::vector<double> table (m_nPoints);
+      if (!is.read (reinterpret_cast<char *> (&table[0]), m_nPoints * sizeof (double)))
+        {
+          NS_LOG_WARN ("Truncated table " << name << " in " << m_cacheFile);
+          break;
+        }
+      m_tables[name].swap (table);
+    }
+  NS_LOG_DEBUG ("Read " << m_tables.size () << " tables from " << m_cacheFile);
+}
+
+void
+TableErrorRateModel::WriteCache (void) const
+{
+  NS_LOG_FUNCTION (this);
+  std::ofstream os (m_cacheFile.c_str (), std::ios::binary | std::ios::trunc);
+  if (!os)
+    {
+      NS_LOG_WARN ("Cannot write the tables to " << m_cacheFile);
+      return;
+    }
+  os << GetCacheHeader () << "\n";
+  for (std::map<std::string, std::vector<double> >::const_iterator i = m_tables.begin (); i != m_tables.end (); ++i)
+    {
+      os << i->first << "\n";
+      os.write (reinterpret_cast<const char *> (&i->second[0]), m_nPoints * sizeof (double));
+    }
+}
+
+double
+TableErrorRateModel::ComputeValue (WifiMode mode, WifiTxVector txVector, double snrDb) const
+{
+  double snr = std::pow (10.0, snrDb / 10.0);
+  // -log (1 - p), with the chunk success rate of one bit being 1 - p
+  double errorExponent = -std::log (GetBaseModel ()->GetChunkSuccessRate (mode, txVector, snr, 1));
+  double value = errorExponent > 0 ? std::log (errorExponent) : TABLE_MIN_VALUE;
+  return std::max (TABLE_MIN_VALUE, std::min (TABLE_MAX_VALUE, value));
+}
+
+void
+TableErrorRateModel::ComputeTable (WifiMode mode, WifiTxVector txVector, std::vector<double> &table) const
+{
+  NS_LOG_FUNCTION (this << mode);
+  table.resize (m_nPoints);
+  for (uint32_t i = 0; i < m_nPoints; i++)
+    {
+      table[i] = ComputeValue (mode, txVector, m_minSnrDb + i * m_stepDb);
+    }
+  // An error d on the interpolated value changes exp (-nbits * exp (value))
+  // by at most about d / e, whatever nbits. The intervals whose middle is
+  // off by more than the tolerance (where the base model has a sharp knee)
+  // are marked with a NaN and left to the base model.
+  double maxError = M_E * m_tolerance;
+  std::vector<uint32_t> marked;
+  for (uint32_t i = 0; i + 1 < m_nPoints; i++)
+    {
+      double middle = ComputeValue (mode, txVector, m_minSnrDb + (i + 0.5) * m_stepDb);
+      if (std::fabs ((table[i] + table[i + 1]) / 2 - middle) > maxError)
+        {
+          marked.push_back (i);
+        }
+    }
+  for (std::vector<uint32_t>::const_iterator i = marked.begin (); i != marked.end (); ++i)
+    {
+      table[*i] = std::numeric_limits<double>::quiet_NaN ();
+    }
+  NS_LOG_DEBUG (mode << ": " << marked.size () << " intervals out of tolerance");
+}
+
+const std::vector<double> &
+TableErrorRateModel::GetTable (WifiMode mode, WifiTxVector txVector) const
+{
+  // the chunk success rate of the base models depends on the channel
+  // width, guard interval and number of streams through the phy rate
+  uint64_t key = (static_cast<uint64_t> (mode.GetUid ()) << 32)
+    | (static_cast<uint64_t> (txVector.GetChannelWidth () & 0xffff) << 16)
+    | (static_cast<uint64_t> (txVector.GetNss ()) << 1)
+    | (txVector.IsShortGuardInterval () ? 1 : 0);
+  std::map<uint64_t, const std::vector<double> *>::const_iterator it = m_index.find (key);
+  if (it != m_index.end ())
+    {
+      return *it->second;
+    }
+
+  if (!m_cacheRead)
+    {
+      NS_ABORT_MSG_UNLESS (m_maxSnrDb > m_minSnrDb, "MaxSnr must be larger than MinSnr");
+      m_nPoints = static_cast<uint32_t> (std::ceil ((m_maxSnrDb - m_minSnrDb) / m_stepDb)) + 1;
+      ReadCache ();
+    }
+  std::ostringstream oss;
+  oss << mode.GetUniqueName () << " " << txVector.GetChannelWidth ()
+      << " " << (txVector.IsShortGuardInterval () ? 1 : 0)
+      << " " << static_cast<uint32_t> (txVector.GetNss ());
+  std::vector<double> &table = m_tables[oss.str ()];
+  if (table.empty ())
+    {
+      ComputeTable (mode, txVector, table);
+      if (!m_cacheFile.empty ())
+        {
+          WriteCache ();
+        }
+    }
+  m_index[key] = &table;
+  return table;
+}
+
+double
+TableErrorRateModel::GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint32_t nbits) const
+{
+  NS_LOG_FUNCTION (this << mode << txVector.GetMode () << snr << nbits);
+  const std::vector<double> &table = GetTable (mode, txVector);
+  double x = snr > 0 ? (10.0 * std::log10 (snr) - m_minSnrDb) / m_stepDb : -1.0;
+  if (x < 0 || x >= m_nPoints - 1)
+    {
+      return GetBaseModel ()->GetChunkSuccessRate (mode, txVector, snr, nbits);
+    }
+  uint32_t i = static_cast<uint32_t> (x);
+  if (std::isnan (table[i]) || std::isnan (table[i + 1]))
+    {
+      return GetBaseModel ()->GetChunkSuccessRate (mode, txVector, snr, nbits);
+    }
+  double value = table[i] + (x - i) * (table[i + 1] - table[i]);
+  return std::exp (-static_cast<double> (nbits) * std::exp (value));
+}
+
+} //namespace ns3
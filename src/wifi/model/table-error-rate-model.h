@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TABLE_ERROR_RATE_MODEL_H
+#define TABLE_ERROR_RATE_MODEL_H
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "error-rate-model.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * An error rate model which interpolates the chunk success rate of another
+ * error rate model (the NistErrorRateModel by default) from precomputed
+ * tables.
+ *
+ * The chunk success rate of the analytical models is of the form
+ * \f$ (1 - p(snr))^{nbits} \f$. For each combination of WifiMode, channel
+ * width, guard interval and number of spatial streams, a table stores
+ * \f$ \log (-\log (1 - p)) \f$ over a grid of SNR values evenly spaced
+ * in dB, computed from the chunk success rate of one bit when the
+ * combination is first used. This log-log representation is nearly linear
+ * in dB, so that it can be linearly interpolated. The interpolation is
+ * checked in the middle of each step of the grid, and the steps where the
+ * chunk success rate is off by more than the Tolerance attribute, as well
+ * as the SNR values outside of the grid, are forwarded to the base model.
+ *
+ * When the CacheFile attribute is set, the tables are read from this file
+ * and the new tables are written to it, so that they are computed only
+ * once across simulation runs. The cached tables are used only if the
+ * file was written with the same base model type and SNR grid.
+ *
+ * The attributes must be set before the first chunk success rate is
+ * requested.
+ */
+class TableErrorRateModel : public ErrorRateModel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  TableErrorRateModel ();
+  virtual ~TableErrorRateModel ();
+
+  /**
+   * Use an existing error rate model instead of creating one of the
+   * BaseModel type.
+   *
+   * \param model the error rate model to interpolate
+   */
+  void SetBaseModel (Ptr<ErrorRateModel> model);
+  /**
+   * \return the error rate model which is interpolated
+   */
+  Ptr<ErrorRateModel> GetBaseModel (void) const;
+
+  virtual double GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint32_t nbits) const;
+
+
+private:
+  virtual void DoDispose (void);
+
+  /**
+   * Return the table for the given mode and transmission parameters,
+   * reading or computing it if needed.
+   *
+   * \param mode the Wi-Fi mode
+   * \param txVector the transmission parameters
+   *
+   * \return the table
+   */
+  const std::vector<double> & GetTable (WifiMode mode, WifiTxVector txVector) const;
+  /**
+   * Compute a value of a table from the base model.
+   *
+   * \param mode the Wi-Fi mode
+   * \param txVector the transmission parameters
+   * \param snrDb the SNR (dB)
+   *
+   * \return log (-log (1 - p)), bounded
+   */
+  double ComputeValue (WifiMode mode, WifiTxVector txVector, double snrDb) const;
+  /**
+   * Compute a table from the base model.
+   *
+   * \param mode the Wi-Fi mode
+   * \param txVector the transmission parameters
+   * \param table the table to fill
+   */
+  void ComputeTable (WifiMode mode, WifiTxVector txVector, std::vector<double> &table) const;
+  /**
+   * Read the tables of the cache file, if it matches the current grid.
+   */
+  void ReadCache (void) const;
+  /**
+   * Write all the tables to the cache file.
+   */
+  void WriteCache (void) const;
+  /**
+   * \return the header which identifies the base model and grid of the tables
+   */
+  std::string GetCacheHeader (void) const;
+
+  TypeId m_baseModelType;        //!< type of the base model
+  double m_minSnrDb;             //!< smallest SNR of the tables (dB)
+  double m_maxSnrDb;             //!< largest SNR of the tables (dB)
+  double m_stepDb;               //!< SNR step of the tables (dB)
+  double m_tolerance;            //!< largest interpolation error
+  std::string m_cacheFile;       //!< file used to keep the tables between runs
+  mutable uint32_t m_nPoints;    //!< number of SNR values in each table
+  mutable Ptr<ErrorRateModel> m_baseModel; //!< the interpolated model
+  /// Tables identified by mode unique name and transmission parameters
+  mutable std::map<std::string, std::vector<double> > m_tables;
+  /// Tables identified by mode uid and transmission parameters
+  mutable std::map<uint64_t, const std::vector<double> *> m_index;
+  mutable bool m_cacheRead;      //!< whether the cache file was read
+};
+
+} //namespace ns3
+
+#endif /* TABLE_ERROR_RATE_MODEL_H */
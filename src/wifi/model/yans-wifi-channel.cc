@@ -25,6 +25,7 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
 #include "ns3/object-factory.h"
 #include "yans-wifi-channel.h"
 #include "ns3/propagation-loss-model.h"
@@ -51,11 +52,23 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("MaxRange",
+                   "If strictly positive, packets are only delivered to the PHYs "
+                   "which are not farther than this distance (in meters) from the "
+                   "sender, and the propagation models are not evaluated for the "
+                   "others. The PHYs are found with a spatial index, which is "
+                   "rebuilt when PHYs are added to the channel or when this "
+                   "attribute changes. The default value "
+                   "delivers packets to all the PHYs.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&YansWifiChannel::SetMaxRange),
+                   MakeDoubleChecker<double> (0))
   ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_maxRange (0)
 {
 }
 
@@ -83,9 +96,21 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double
 {
   Ptr<MobilityModel> senderMobility = sender->GetMobility ()->GetObject<MobilityModel> ();
   NS_ASSERT (senderMobility != 0);
-  uint32_t j = 0;
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++, j++)
+  std::vector<uint32_t> receivers;
+  if (m_maxRange > 0)
     {
+      if (m_index.GetN () != m_phyList.size ())
+        {
+          BuildIndex ();
+        }
+      m_index.GetInRange (senderMobility->GetPosition (), m_maxRange, receivers);
+    }
+  uint32_t nReceivers = m_maxRange > 0 ? receivers.size () : m_phyList.size ();
+  for (uint32_t k = 0; k < nReceivers; k++)
+    {
+      // the receivers are visited in the PHY list order in both cases
+      uint32_t j = m_maxRange > 0 ? receivers[k] : k;
+      PhyList::const_iterator i = m_phyList.begin () + j;
       if (sender != (*i))
         {
           //For now don't account for inter channel interference
@@ -125,6 +150,28 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double
     }
 }
 
+void
+YansWifiChannel::SetMaxRange (double maxRange)
+{
+  NS_LOG_FUNCTION (this << maxRange);
+  m_maxRange = maxRange;
+  // the cells of the index are as large as the range: rebuild it on the
+  // next transmission
+  m_index.Clear ();
+}
+
+void
+YansWifiChannel::BuildIndex (void) const
+{
+  NS_LOG_FUNCTION (this);
+  m_index.SetCellSize (m_maxRange);
+  for (uint32_t j = 0; j < m_phyList.size (); j++)
+    {
+      Ptr<Object> mobility = m_phyList[j]->GetMobility ();
+      m_index.Add (j, mobility != 0 ? mobility->GetObject<MobilityModel> () : 0);
+    }
+}
+
 void
 YansWifiChannel::Receive (uint32_t i, Ptr<Packet> packet, struct Parameters parameters) const
 {
@@ -30,6 +30,7 @@
 #include "wifi-tx-vector.h"
 #include "yans-wifi-phy.h"
 #include "ns3/nstime.h"
+#include "ns3/mobility-grid-index.h"
 
 namespace ns3 {
 
@@ -57,6 +58,13 @@ struct Parameters
  * class and contains a ns3::PropagationLossModel and a ns3::PropagationDelayModel.
  * By default, no propagation models are set so, it is the caller's responsability
  * to set them before using the channel.
+ *
+ * In large topologies, the MaxRange attribute can be set to the distance
+ * beyond which transmissions are negligible, so that each transmission
+ * only evaluates the propagation models for the PHYs within this range.
+ * The deliveries to these PHYs are unchanged, as long as the propagation
+ * loss model does not draw random variables (skipping far PHYs changes the
+ * sequence of values drawn for the others).
  */
 class YansWifiChannel : public WifiChannel
 {
@@ -134,9 +142,23 @@ private:
    */
   void Receive (uint32_t i, Ptr<Packet> packet, struct Parameters parameters) const;
 
+  /**
+   * Set the maximum distance of the receivers, and clear the spatial index.
+   *
+   * \param maxRange the maximum distance (m), 0 for no limit
+   */
+  void SetMaxRange (double maxRange);
+
+  /**
+   * Add all the PHYs of the list to the spatial index.
+   */
+  void BuildIndex (void) const;
+
   PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
   Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
   Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+  double m_maxRange;                   //!< Maximum distance of the receivers, 0 for no limit
+  mutable MobilityGridIndex m_index;   //!< Positions of the PHYs, used if m_maxRange is positive
 };
 
 } //namespace ns3
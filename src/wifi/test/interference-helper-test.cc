@@ -0,0 +1,234 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/wifi-phy.h"
+
+using namespace ns3;
+
+/**
+ * Check the SNR and payload PER computed by the InterferenceHelper for
+ * overlapping events, including events starting at the same time, against
+ * the chunk success rates of the error rate model, and check that the
+ * changes of the power level which are no longer needed are removed.
+ */
+class InterferenceHelperTest : public TestCase
+{
+public:
+  InterferenceHelperTest ();
+  virtual ~InterferenceHelperTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \return the noise floor (W)
+   */
+  double GetNoiseW (void) const;
+  /**
+   * \param snr the SNR (linear)
+   * \param duration the duration of the chunk
+   * \return the success rate of a payload chunk
+   */
+  double GetChunkSuccessRate (double snr, Time duration) const;
+  /**
+   * Add an event to the interference helper.
+   * \param powerW the received power (W)
+   * \param duration the duration of the event
+   */
+  void AddEvent (double powerW, Time duration);
+  /// Start receiving the last added event
+  void StartRx (void);
+  /// Check an event with an interferer during its payload
+  void CheckOverlap (void);
+  /// Check three events starting at the same time
+  void CheckSameStart (void);
+  /// Check the changes kept while not receiving
+  void CheckIdleTrimming (void);
+  /// Check a reception after the trimming, and the trimming at its end
+  void CheckRxTrimming (void);
+
+  InterferenceHelper m_interference; //!< the interference helper under test
+  Ptr<NistErrorRateModel> m_errorRateModel; //!< the error rate model
+  WifiTxVector m_txVector; //!< the TXVECTOR of all the events
+  std::vector<Ptr<InterferenceHelper::Event> > m_events; //!< the events added so far
+  static const double m_noiseFigure; //!< the noise figure (linear)
+};
+
+const double InterferenceHelperTest::m_noiseFigure = 5.0;
+
+InterferenceHelperTest::InterferenceHelperTest ()
+  : TestCase ("Check the SNR, the PER and the trimming of the InterferenceHelper")
+{
+}
+
+InterferenceHelperTest::~InterferenceHelperTest ()
+{
+}
+
+double
+InterferenceHelperTest::GetNoiseW (void) const
+{
+  // thermal noise at 290K
+  return m_noiseFigure * 1.3803e-23 * 290.0 * m_txVector.GetChannelWidth () * 1000000;
+}
+
+double
+InterferenceHelperTest::GetChunkSuccessRate (double snr, Time duration) const
+{
+  WifiMode mode = m_txVector.GetMode ();
+  uint64_t nbits = (uint64_t)(mode.GetPhyRate (m_txVector) * duration.GetSeconds ());
+  return m_errorRateModel->GetChunkSuccessRate (mode, m_txVector, snr, (uint32_t)nbits);
+}
+
+void
+InterferenceHelperTest::AddEvent (double powerW, Time duration)
+{
+  m_events.push_back (m_interference.Add (1000, m_txVector, WIFI_PREAMBLE_LONG, duration, powerW));
+}
+
+void
+InterferenceHelperTest::StartRx (void)
+{
+  m_interference.NotifyRxStart ();
+}
+
+void
+InterferenceHelperTest::CheckOverlap (void)
+{
+  // 1e-12 W from 0 to 2 ms, and an interferer of 5e-13 W from 500 to 800 us
+  Ptr<InterferenceHelper::Event> event = m_events[0];
+  Time payloadStart = event->GetStartTime ()
+    + WifiPhy::GetPlcpPreambleDuration (m_txVector, WIFI_PREAMBLE_LONG)
+    + WifiPhy::GetPlcpHeaderDuration (m_txVector, WIFI_PREAMBLE_LONG);
+  double noise = GetNoiseW ();
+  double psr = GetChunkSuccessRate (1e-12 / noise, MicroSeconds (500) - payloadStart)
+    * GetChunkSuccessRate (1e-12 / (noise + 5e-13), MicroSeconds (300))
+    * GetChunkSuccessRate (1e-12 / noise, MicroSeconds (1200));
+  InterferenceHelper::SnrPer snrPer = m_interference.CalculatePlcpPayloadSnrPer (event);
+  NS_TEST_EXPECT_MSG_EQ_TOL (snrPer.snr, 1e-12 / noise, 1e-9, "Wrong SNR");
+  NS_TEST_EXPECT_MSG_EQ_TOL (snrPer.per, 1 - psr, 1e-9, "Wrong PER with an interferer");
+  NS_TEST_EXPECT_MSG_GT (snrPer.per, 0, "The interferer should cause errors");
+  m_interference.NotifyRxEnd ();
+  m_events.clear ();
+}
+
+void
+InterferenceHelperTest::CheckSameStart (void)
+{
+  // three events of 1 ms starting at the same time: each one is
+  // interfered by the two others during its whole payload
+  double powers[] = { 1e-12, 5e-13, 2e-13 };
+  double noise = GetNoiseW ();
+  for (uint32_t i = 0; i < m_events.size (); i++)
+    {
+      Ptr<InterferenceHelper::Event> event = m_events[i];
+      Time payloadStart = event->GetStartTime ()
+        + WifiPhy::GetPlcpPreambleDuration (m_txVector, WIFI_PREAMBLE_LONG)
+        + WifiPhy::GetPlcpHeaderDuration (m_txVector, WIFI_PREAMBLE_LONG);
+      double interference = powers[0] + powers[1] + powers[2] - powers[i];
+      double psr = GetChunkSuccessRate (powers[i] / (noise + interference),
+                                        event->GetEndTime () - payloadStart);
+      InterferenceHelper::SnrPer snrPer = m_interference.CalculatePlcpPayloadSnrPer (event);
+      NS_TEST_EXPECT_MSG_EQ_TOL (snrPer.per, 1 - psr, 1e-9, "Wrong PER of event " << i);
+    }
+  m_interference.NotifyRxEnd ();
+  m_events.clear ();
+}
+
+void
+InterferenceHelperTest::CheckIdleTrimming (void)
+{
+  // only the level before the last event, and the changes of the last
+  // event, are kept
+  NS_TEST_EXPECT_MSG_EQ (m_interference.m_niChanges.size (), 3, "Old changes kept while not receiving");
+  m_events.clear ();
+}
+
+void
+InterferenceHelperTest::CheckRxTrimming (void)
+{
+  // the interferer ended before: only the noise remains
+  Ptr<InterferenceHelper::Event> event = m_events.back ();
+  Time payloadStart = event->GetStartTime ()
+    + WifiPhy::GetPlcpPreambleDuration (m_txVector, WIFI_PREAMBLE_LONG)
+    + WifiPhy::GetPlcpHeaderDuration (m_txVector, WIFI_PREAMBLE_LONG);
+  double noise = GetNoiseW ();
+  double psr = GetChunkSuccessRate (1e-12 / noise, event->GetEndTime () - payloadStart);
+  InterferenceHelper::SnrPer snrPer = m_interference.CalculatePlcpPayloadSnrPer (event);
+  NS_TEST_EXPECT_MSG_EQ_TOL (snrPer.snr, 1e-12 / noise, 1e-9, "Ended events still counted");
+  NS_TEST_EXPECT_MSG_EQ_TOL (snrPer.per, 1 - psr, 1e-9, "Wrong PER after the trimming");
+  m_interference.NotifyRxEnd ();
+  // the level before the end of the event, and its end
+  NS_TEST_EXPECT_MSG_EQ (m_interference.m_niChanges.size (), 2, "Changes kept after the reception");
+  m_events.clear ();
+}
+
+void
+InterferenceHelperTest::DoRun (void)
+{
+  m_errorRateModel = CreateObject<NistErrorRateModel> ();
+  m_interference.SetErrorRateModel (m_errorRateModel);
+  m_interference.SetNoiseFigure (m_noiseFigure);
+  m_txVector.SetMode (WifiPhy::GetOfdmRate6Mbps ());
+  m_txVector.SetChannelWidth (20);
+
+  Simulator::Schedule (Seconds (0), &InterferenceHelperTest::AddEvent, this, 1e-12, MicroSeconds (2000));
+  Simulator::Schedule (Seconds (0), &InterferenceHelperTest::StartRx, this);
+  Simulator::Schedule (MicroSeconds (500), &InterferenceHelperTest::AddEvent, this, 5e-13, MicroSeconds (300));
+  Simulator::Schedule (MicroSeconds (2000), &InterferenceHelperTest::CheckOverlap, this);
+
+  Simulator::Schedule (MilliSeconds (10), &InterferenceHelperTest::AddEvent, this, 1e-12, MicroSeconds (1000));
+  Simulator::Schedule (MilliSeconds (10), &InterferenceHelperTest::AddEvent, this, 5e-13, MicroSeconds (1000));
+  Simulator::Schedule (MilliSeconds (10), &InterferenceHelperTest::AddEvent, this, 2e-13, MicroSeconds (1000));
+  Simulator::Schedule (MilliSeconds (10), &InterferenceHelperTest::StartRx, this);
+  Simulator::Schedule (MilliSeconds (11), &InterferenceHelperTest::CheckSameStart, this);
+
+  for (uint32_t i = 0; i < 50; i++)
+    {
+      Simulator::Schedule (MilliSeconds (20) + MicroSeconds (100 * i),
+                           &InterferenceHelperTest::AddEvent, this, 1e-12, MicroSeconds (50));
+    }
+  Simulator::Schedule (MilliSeconds (25), &InterferenceHelperTest::CheckIdleTrimming, this);
+
+  Simulator::Schedule (MilliSeconds (30), &InterferenceHelperTest::AddEvent, this, 1e-12, MicroSeconds (1000));
+  Simulator::Schedule (MilliSeconds (30), &InterferenceHelperTest::StartRx, this);
+  Simulator::Schedule (MilliSeconds (31), &InterferenceHelperTest::CheckRxTrimming, this);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_interference.EraseEvents ();
+}
+
+/**
+ * InterferenceHelper test suite
+ */
+class InterferenceHelperTestSuite : public TestSuite
+{
+public:
+  InterferenceHelperTestSuite ();
+};
+
+InterferenceHelperTestSuite::InterferenceHelperTestSuite ()
+  : TestSuite ("wifi-interference-helper", UNIT)
+{
+  AddTestCase (new InterferenceHelperTest, TestCase::QUICK);
+}
+
+static InterferenceHelperTestSuite interferenceHelperTestSuite;
@@ -23,6 +23,9 @@
 #include "ns3/dsss-error-rate-model.h"
 #include "ns3/yans-error-rate-model.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/table-error-rate-model.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/string.h"
 
 using namespace ns3;
 
@@ -279,6 +282,94 @@ WifiErrorRateModelsTestCaseNist::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.999, 0.001, "Not equal within tolerance");
 }
 
+class WifiErrorRateModelsTestCaseTable : public TestCase
+{
+public:
+  WifiErrorRateModelsTestCaseTable ();
+  virtual ~WifiErrorRateModelsTestCaseTable ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Compare the table model with its base model.
+   *
+   * \param table the table error rate model
+   */
+  void CheckTable (Ptr<TableErrorRateModel> table);
+};
+
+WifiErrorRateModelsTestCaseTable::WifiErrorRateModelsTestCaseTable ()
+  : TestCase ("WifiErrorRateModel test case table")
+{
+}
+
+WifiErrorRateModelsTestCaseTable::~WifiErrorRateModelsTestCaseTable ()
+{
+}
+
+void
+WifiErrorRateModelsTestCaseTable::CheckTable (Ptr<TableErrorRateModel> table)
+{
+  std::vector<WifiMode> modes;
+  modes.push_back (WifiPhy::GetDsssRate1Mbps ());
+  modes.push_back (WifiPhy::GetDsssRate11Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate6Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate9Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate24Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate48Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate54Mbps ());
+  modes.push_back (WifiPhy::GetHtMcs0 ());
+  modes.push_back (WifiPhy::GetHtMcs7 ());
+  modes.push_back (WifiPhy::GetVhtMcs8 ());
+  modes.push_back (WifiPhy::GetVhtMcs9 ());
+  uint32_t sizes[] = {1, 8, 100, 1000, 16000};
+  Ptr<ErrorRateModel> base = table->GetBaseModel ();
+
+  for (std::vector<WifiMode>::const_iterator mode = modes.begin (); mode != modes.end (); ++mode)
+    {
+      WifiTxVector txVector;
+      txVector.SetMode (*mode);
+      txVector.SetChannelWidth (mode->GetModulationClass () == WIFI_MOD_CLASS_VHT ? 80 : 20);
+      for (double snrDb = -15.0; snrDb < 65.0; snrDb += 0.37)
+        {
+          double snr = std::pow (10.0, snrDb / 10.0);
+          for (uint32_t i = 0; i < sizeof (sizes) / sizeof (sizes[0]); i++)
+            {
+              double expected = base->GetChunkSuccessRate (*mode, txVector, snr, sizes[i]);
+              double ps = table->GetChunkSuccessRate (*mode, txVector, snr, sizes[i]);
+              NS_TEST_ASSERT_MSG_EQ_TOL (ps, expected, 1e-3, "Wrong chunk success rate for " << *mode
+                                         << " at " << snrDb << " dB with " << sizes[i] << " bits");
+            }
+        }
+    }
+}
+
+void
+WifiErrorRateModelsTestCaseTable::DoRun (void)
+{
+  Ptr<TableErrorRateModel> table = CreateObject<TableErrorRateModel> ();
+  CheckTable (table);
+
+  table = CreateObject<TableErrorRateModel> ();
+  table->SetBaseModel (CreateObject<YansErrorRateModel> ());
+  CheckTable (table);
+
+  // tables read from the cache file are identical to the computed ones
+  std::string cacheFile = CreateTempDirFilename ("table-error-rate-model.bin");
+  table = CreateObject<TableErrorRateModel> ();
+  table->SetAttribute ("CacheFile", StringValue (cacheFile));
+  Ptr<TableErrorRateModel> cached = CreateObject<TableErrorRateModel> ();
+  cached->SetAttribute ("CacheFile", StringValue (cacheFile));
+  WifiTxVector txVector;
+  for (double snrDb = 0.0; snrDb < 30.0; snrDb += 0.1)
+    {
+      double snr = std::pow (10.0, snrDb / 10.0);
+      double expected = table->GetChunkSuccessRate (WifiPhy::GetOfdmRate36Mbps (), txVector, snr, 1000);
+      double ps = cached->GetChunkSuccessRate (WifiPhy::GetOfdmRate36Mbps (), txVector, snr, 1000);
+      NS_TEST_ASSERT_MSG_EQ (ps, expected, "Wrong cached chunk success rate at " << snrDb << " dB");
+    }
+}
+
 class WifiErrorRateModelsTestSuite : public TestSuite
 {
 public:
@@ -290,6 +381,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite ()
 {
   AddTestCase (new WifiErrorRateModelsTestCaseDsss, TestCase::QUICK);
   AddTestCase (new WifiErrorRateModelsTestCaseNist, TestCase::QUICK);
+  AddTestCase (new WifiErrorRateModelsTestCaseTable, TestCase::QUICK);
 }
 
 static WifiErrorRateModelsTestSuite wifiErrorRateModelsTestSuite;